@@ -56,6 +56,7 @@
 #endif
 
 #include "cJSON.h"
+#include "fastfloat.h"
 
 /* define our own boolean type */
 #ifdef true
@@ -243,6 +244,7 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             global_hooks.deallocate(item->string);
         }
+        cJSON_UnindexObject(item);
         global_hooks.deallocate(item);
         item = next;
     }
@@ -280,53 +282,17 @@ typedef struct
 static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
     double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
-    size_t i = 0;
+    size_t length = 0;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
         return false;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_c_string[i] = buffer_at_offset(input_buffer)[i];
-                break;
-
-            case '.':
-                number_c_string[i] = decimal_point;
-                break;
-
-            default:
-                goto loop_end;
-        }
-    }
-loop_end:
-    number_c_string[i] = '\0';
-
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    /* parse without copying the number and independent of the current locale,
+     * giving the same value as strtod() */
+    length = fastfloatParse((const char*)buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number);
+    if (length == 0)
     {
         return false; /* parse_error */
     }
@@ -349,7 +315,7 @@ loop_end:
 
     item->type = cJSON_Number;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
+    input_buffer->offset += length;
     return true;
 }
 
@@ -1790,21 +1756,136 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
     return get_array_item(array, (size_t)index);
 }
 
+/* Hash index of the members of an object: open addressing with linear probing in a table whose size is a power of two.
+ * Members are inserted in list order and never removed, so of several members with the same name
+ * the first one in the list is also the first one on the probe sequence, just as with the linear search. */
+struct cJSON_ObjectIndex
+{
+    size_t mask; /* size of the table minus 1 */
+    cJSON *slots[1];
+};
+
+/* FNV-1a of the lowercased name, so that case sensitive and case insensitive lookups can share the index */
+static size_t hash_name(const unsigned char *name)
+{
+    size_t hash = (size_t)2166136261U;
+
+    for (; *name != '\0'; name++)
+    {
+        hash ^= (size_t)tolower(*name);
+        hash *= (size_t)16777619U;
+    }
+
+    return hash;
+}
+
+CJSON_PUBLIC(void) cJSON_UnindexObject(cJSON *object)
+{
+    if ((object != NULL) && (object->index != NULL))
+    {
+        global_hooks.deallocate(object->index);
+        object->index = NULL;
+    }
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object)
+{
+    struct cJSON_ObjectIndex *index = NULL;
+    cJSON *child = NULL;
+    size_t count = 0;
+    size_t size = 1;
+    size_t slot = 0;
+
+    if (!cJSON_IsObject(object))
+    {
+        return false;
+    }
+
+    if (object->index != NULL)
+    {
+        return true;
+    }
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        count++;
+    }
+
+    /* keep the table at most half full, so probe sequences stay short and always end at an empty slot */
+    while (size < 2 * count)
+    {
+        size <<= 1;
+    }
+
+    index = (struct cJSON_ObjectIndex*)global_hooks.allocate(sizeof(struct cJSON_ObjectIndex) + (size - 1) * sizeof(cJSON*));
+    if (index == NULL)
+    {
+        return false;
+    }
+    memset(index->slots, '\0', size * sizeof(cJSON*));
+    index->mask = size - 1;
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        if (child->string == NULL)
+        {
+            continue;
+        }
+
+        slot = hash_name((const unsigned char*)child->string) & index->mask;
+        while (index->slots[slot] != NULL)
+        {
+            slot = (slot + 1) & index->mask;
+        }
+        index->slots[slot] = child;
+    }
+
+    object->index = index;
+
+    return true;
+}
+
+static cJSON *get_indexed_item(const struct cJSON_ObjectIndex * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    cJSON *candidate = NULL;
+    size_t slot = hash_name((const unsigned char*)name) & index->mask;
+
+    while ((candidate = index->slots[slot]) != NULL)
+    {
+        if (case_sensitive ? (strcmp(name, candidate->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(candidate->string)) == 0))
+        {
+            return candidate;
+        }
+        slot = (slot + 1) & index->mask;
+    }
+
+    return NULL;
+}
+
+static void* cast_away_const(const void* string);
+
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
+    size_t compared = 0;
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
+    if (object->index != NULL)
+    {
+        return get_indexed_item(object->index, name, case_sensitive);
+    }
+
     current_element = object->child;
     if (case_sensitive)
     {
         while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
         {
             current_element = current_element->next;
+            compared++;
         }
     }
     else
@@ -1812,9 +1893,17 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
         while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
         {
             current_element = current_element->next;
+            compared++;
         }
     }
 
+    /* a long search makes it likely that more lookups in this object follow, so index it for those
+     * if the index cannot be allocated, lookups just stay linear */
+    if ((CJSON_INDEX_MIN_ITEMS > 0) && (compared >= CJSON_INDEX_MIN_ITEMS))
+    {
+        cJSON_IndexObject((cJSON*)cast_away_const(object));
+    }
+
     if ((current_element == NULL) || (current_element->string == NULL)) {
         return NULL;
     }
@@ -1861,6 +1950,7 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
+    reference->index = NULL;
     reference->type |= cJSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
@@ -1875,6 +1965,8 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         return false;
     }
 
+    cJSON_UnindexObject(array);
+
     child = array->child;
 
     if (child == NULL)
@@ -2100,6 +2192,8 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+    cJSON_UnindexObject(parent);
+
     if (item->prev != NULL)
     {
         /* not the first element */
@@ -2179,6 +2273,8 @@ CJSON_PUBLIC(void) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newit
         return;
     }
 
+    cJSON_UnindexObject(array);
+
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2204,6 +2300,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+    cJSON_UnindexObject(parent);
+
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -120,6 +120,9 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+    /* Hash index of the members of an object, built on demand by cJSON_IndexObject or on the first lookup by name. Internal, do not touch. */
+    struct cJSON_ObjectIndex *index;
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -137,6 +140,12 @@ typedef int cJSON_bool;
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
+/* An object gets a hash index when a lookup by name had to pass at least this many members,
+ * so that further lookups take constant time instead of comparing with every member. 0 disables this. */
+#ifndef CJSON_INDEX_MIN_ITEMS
+#define CJSON_INDEX_MIN_ITEMS 16
+#endif
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
@@ -170,6 +179,11 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Build a hash index of the members of an object, regardless of its size, so that lookups by name take constant time.
+ * The index is dropped when members are added, detached or replaced via the functions below.
+ * If you modify child, next or string of the members directly, call cJSON_UnindexObject afterwards. */
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object);
+CJSON_PUBLIC(void) cJSON_UnindexObject(cJSON *object);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
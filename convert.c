@@ -4,8 +4,11 @@
 #include <assert.h>
 #include <math.h>
 #include <float.h>  /* for DBL_MAX */
+#include <limits.h>  /* for INT_MAX */
 
 #include "convert.h"
+#include "decomp.h"
+#include "presolve.h"
 
 #include "gmomcc.h"
 #include "gevmcc.h"
@@ -15,6 +18,36 @@
 
 const char* VARNAMEPREFIX[7] = { "x", "b", "i", "x", "x", "y", "j" };
 
+/** whether a variable is written, that is, it has not been removed and belongs to the block that is written */
+static
+int iswrittenvar(
+   const presolve_t* presolve,
+   const decomp_t*   decomp,
+   int               block,
+   int               i
+   )
+{
+   if( presolve != NULL && presolve->colremoved[i] )
+      return 0;
+
+   return decomp == NULL || decomp->colblock[i] == block;
+}
+
+/** whether a row is written, that is, it has not been removed and belongs to the block that is written */
+static
+int iswrittenrow(
+   const presolve_t* presolve,
+   const decomp_t*   decomp,
+   int               block,
+   int               i
+   )
+{
+   if( presolve != NULL && presolve->rowremoved[i] )
+      return 0;
+
+   return decomp == NULL || decomp->rowblock[i] == block;
+}
+
 RETURN convertEndLine(
    DECL_convertWriteFunc((*writefunc)),
    void*       writedata,
@@ -74,6 +107,26 @@ void convertGetVarName(
    sprintf(buffer, "%s%d", VARNAMEPREFIX[gmoGetVarTypeOne(gmo, idx)], idx);
 }
 
+int convertParseVarIdx(
+   const char* name
+   )
+{
+   int idx = 0;
+
+   /* skip prefix, which is a single character */
+   if( name[0] == '\0' || name[1] == '\0' )
+      return -1;
+
+   for( ++name; *name != '\0'; ++name )
+   {
+      if( *name < '0' || *name > '9' || idx > (INT_MAX - 9) / 10 )
+         return -1;
+      idx = 10 * idx + (*name - '0');
+   }
+
+   return idx;
+}
+
 void convertGetEquName(
    gmoHandle_t gmo,
    int         idx,
@@ -178,6 +231,9 @@ RETURN writeStatistics(
 static
 RETURN writeBounds(
    gmoHandle_t gmo,
+   const presolve_t* presolve,
+   const decomp_t* decomp,
+   int         block,
    DECL_convertWriteFunc((*writefunc)),
    void*       writedata,
    char*       linebuffer,
@@ -188,14 +244,21 @@ RETURN writeBounds(
    char buffer[PRINTLEN];
    int i;
    int printedsecname = 0;
+   double objconst = presolve != NULL ? presolve->objconst : gmoObjConst(gmo);
+
+   if( decomp != NULL && block != 0 )
+      objconst = 0.0;
 
    for( i = 0; i < gmoN(gmo); ++i )
    {
       double lb, ub;
       double defub;
 
-      lb = gmoGetVarLowerOne(gmo, i);
-      ub = gmoGetVarUpperOne(gmo, i);
+      if( !iswrittenvar(presolve, decomp, block, i) )
+         continue;
+
+      lb = presolve != NULL ? presolve->lb[i] : gmoGetVarLowerOne(gmo, i);
+      ub = presolve != NULL ? presolve->ub[i] : gmoGetVarUpperOne(gmo, i);
       defub = (gmoGetVarTypeOne(gmo, i) == gmovar_B) ? 1.0 : gmoPinf(gmo);
 
       if( lb == 0.0 && ub == defub )  /* default .lp bounds -> skip */
@@ -249,7 +312,7 @@ RETURN writeBounds(
       CHECK( convertEndLine(writefunc, writedata, linebuffer, linecnt) );
    }
 
-   if( doobjconstant && gmoObjConst(gmo) != 0.0 )
+   if( doobjconstant && objconst != 0.0 )
    {
       if( !printedsecname )
       {
@@ -257,7 +320,7 @@ RETURN writeBounds(
          CHECK( convertEndLine(writefunc, writedata, linebuffer, linecnt) );
          printedsecname = 1;
       }
-      sprintf(buffer, " objconstant = " CONVERT_DOUBLEFORMAT, gmoObjConst(gmo));
+      sprintf(buffer, " objconstant = " CONVERT_DOUBLEFORMAT, objconst);
       CHECK( convertAppendLine(writefunc, writedata, linebuffer, linecnt, buffer) );
       CHECK( convertEndLine(writefunc, writedata, linebuffer, linecnt) );
    }
@@ -271,6 +334,9 @@ RETURN writeBounds(
 static
 RETURN writeVartypes(
    gmoHandle_t gmo,
+   const presolve_t* presolve,
+   const decomp_t* decomp,
+   int         block,
    DECL_convertWriteFunc((*writefunc)),
    void*       writedata,
    char*       linebuffer,
@@ -286,7 +352,7 @@ RETURN writeVartypes(
       printedsecname = 0;
       for( i = 0; i < gmoN(gmo); ++i )
       {
-         if( gmoGetVarTypeOne(gmo, i) != gmovar_B )
+         if( gmoGetVarTypeOne(gmo, i) != gmovar_B || !iswrittenvar(presolve, decomp, block, i) )
             continue;
 
          if( !printedsecname )
@@ -315,7 +381,7 @@ RETURN writeVartypes(
       printedsecname = 0;
       for( i = 0; i < gmoN(gmo); ++i )
       {
-         if( gmoGetVarTypeOne(gmo, i) != gmovar_I )
+         if( gmoGetVarTypeOne(gmo, i) != gmovar_I || !iswrittenvar(presolve, decomp, block, i) )
             continue;
 
          if( !printedsecname )
@@ -344,7 +410,7 @@ RETURN writeVartypes(
       printedsecname = 0;
       for( i = 0; i < gmoN(gmo); ++i )
       {
-         if( gmoGetVarTypeOne(gmo, i) != gmovar_SC )
+         if( gmoGetVarTypeOne(gmo, i) != gmovar_SC || !iswrittenvar(presolve, decomp, block, i) )
             continue;
 
          if( !printedsecname )
@@ -503,6 +569,9 @@ RETURN writeLPFunction(
 RETURN writeLP(
    gmoHandle_t gmo,
    gevHandle_t gev,
+   const presolve_t* presolve,
+   const decomp_t* decomp,
+   int         block,
    DECL_convertWriteFunc((*writefunc)),
    void*          writedata
 )
@@ -522,6 +591,7 @@ RETURN writeLP(
 
    int nlnz;
    int i;
+   int k;
 
    assert(gmo != NULL);
    assert(gev != NULL);
@@ -594,13 +664,26 @@ RETURN writeLP(
       }
    }
 
+   /* leave out removed variables; the objective still lists all others, so that each appears in the file */
+   if( presolve != NULL || decomp != NULL )
+   {
+      for( i = 0, k = 0; i < linnz; ++i )
+         if( iswrittenvar(presolve, decomp, block, i) )
+         {
+            lincolidx[k] = i;
+            lincoef[k] = lincoef[i];
+            ++k;
+         }
+      linnz = k;
+   }
+
    CHECK( writeLPFunction(gmo, writefunc, writedata, linebuffer, &linecnt,
       lincolidx, lincoef, linnz,
       quadcolidx, quadrowidx, quadcoef, quadnz) );
    if( quadnz > 0 )
       CHECK( convertAppendLine(writefunc, writedata, linebuffer, &linecnt, "/2") );
 
-   if( gmoObjConst(gmo) != 0.0 )
+   if( (presolve != NULL ? presolve->objconst : gmoObjConst(gmo)) != 0.0 && (decomp == NULL || block == 0) )
       CHECK( convertAppendLine(writefunc, writedata, linebuffer, &linecnt, " + objconstant") );
 
    CHECK( convertEndLine(writefunc, writedata, linebuffer, &linecnt) );
@@ -612,6 +695,9 @@ RETURN writeLP(
 
    for( i = 0; i < gmoM(gmo); ++i )
    {
+      if( !iswrittenrow(presolve, decomp, block, i) )
+         continue;
+
       buffer[0] = ' ';
       convertGetEquName(gmo, i, buffer+1);
       strcat(buffer, ": ");
@@ -620,6 +706,19 @@ RETURN writeLP(
       gmoGetRowSparse(gmo, i, lincolidx, lincoef, NULL, &linnz, &nlnz);
       assert(nlnz == 0);
 
+      /* all variables of a row of a block are in the block, so only removed variables need to be left out */
+      if( presolve != NULL )
+      {
+         for( k = 0, nlnz = 0; k < linnz; ++k )
+            if( !presolve->colremoved[lincolidx[k]] )
+            {
+               lincolidx[nlnz] = lincolidx[k];
+               lincoef[nlnz] = lincoef[k];
+               ++nlnz;
+            }
+         linnz = nlnz;
+      }
+
       quadnz = 0;
       if( gmoGetEquOrderOne(gmo, i) == gmoorder_Q )
       {
@@ -649,7 +748,7 @@ RETURN writeLP(
             return RETURN_ERROR;
       }
 
-      sprintf(buffer, CONVERT_DOUBLEFORMAT, gmoGetRhsOne(gmo, i));
+      sprintf(buffer, CONVERT_DOUBLEFORMAT, presolve != NULL ? presolve->rhs[i] : gmoGetRhsOne(gmo, i));
       CHECK( convertAppendLine(writefunc, writedata, linebuffer, &linecnt, buffer) );
 
       CHECK( convertEndLine(writefunc, writedata, linebuffer, &linecnt) );
@@ -663,12 +762,66 @@ RETURN writeLP(
    free(quadcolidx);
    free(quadcoef);
 
-   CHECK( writeBounds(gmo, writefunc, writedata, linebuffer, &linecnt, 1) );
+   CHECK( writeBounds(gmo, presolve, decomp, block, writefunc, writedata, linebuffer, &linecnt, 1) );
 
-   CHECK( writeVartypes(gmo, writefunc, writedata, linebuffer, &linecnt) );
+   CHECK( writeVartypes(gmo, presolve, decomp, block, writefunc, writedata, linebuffer, &linecnt) );
 
    CHECK( convertAppendLine(writefunc, writedata, linebuffer, &linecnt, "End") );
    CHECK( convertEndLine(writefunc, writedata, linebuffer, &linecnt) );
 
    return RETURN_OK;
 }
+
+RETURN writeMST(
+   gmoHandle_t gmo,
+   gevHandle_t gev,
+   const presolve_t* presolve,
+   const decomp_t* decomp,
+   int         block,
+   DECL_convertWriteFunc((*writefunc)),
+   void*       writedata
+)
+{
+   char linebuffer[MAX_PRINTLEN];
+   char buffer[PRINTLEN];
+   double* levels;
+   int linecnt;
+   int i;
+
+   assert(gmo != NULL);
+   assert(gev != NULL);
+   assert(writefunc != NULL);
+
+   levels = (double*) malloc((gmoN(gmo) + 1) * sizeof(double));
+   if( levels == NULL )
+      return RETURN_ERROR;
+   gmoGetVarL(gmo, levels);
+
+   linebuffer[0] = '\0';
+   linecnt = 0;
+
+   for( i = 0; i < gmoN(gmo); ++i )
+   {
+      double level = levels[i];
+
+      if( !iswrittenvar(presolve, decomp, block, i) )
+         continue;
+
+      /* levels of integer variables are often slightly off, which would make a solver reject the start */
+      if( gmoGetVarTypeOne(gmo, i) == gmovar_B || gmoGetVarTypeOne(gmo, i) == gmovar_I )
+         level = floor(level + 0.5);
+
+      convertGetVarName(gmo, i, buffer);
+      sprintf(buffer + strlen(buffer), " " CONVERT_DOUBLEFORMAT, level);
+      if( convertAppendLine(writefunc, writedata, linebuffer, &linecnt, buffer) != RETURN_OK ||
+         convertEndLine(writefunc, writedata, linebuffer, &linecnt) != RETURN_OK )
+      {
+         free(levels);
+         return RETURN_ERROR_WRITEFUNC;
+      }
+   }
+
+   free(levels);
+
+   return RETURN_OK;
+}
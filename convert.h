@@ -22,6 +22,8 @@ typedef enum {
 
 struct gmoRec;
 struct gevRec;
+struct presolve_s;
+struct decomp_s;
 
 #define DECL_convertWriteFunc(x) size_t x ( \
    const char* msg, \
@@ -52,6 +54,15 @@ void convertGetVarName(
    char*       buffer
    );
 
+/** parses the index of a variable from a name as given by convertGetVarName(), e.g., 42 from x42
+ *
+ * @return index of variable, or -1 if name is not of this form
+ */
+extern
+int convertParseVarIdx(
+   const char* name
+   );
+
 extern
 void convertGetEquName(
    struct gmoRec* gmo,
@@ -59,10 +70,31 @@ void convertGetEquName(
    char*       buffer
    );
 
+/** writes the instance in .lp format
+ *
+ * If reductions are given, then removed variables and rows are left out, and the bounds and right-hand sides
+ * of the reduced model are written. If a decomposition is given, then only the variables and rows of one block are written,
+ * and the objective constant only with block 0.
+ */
 extern
 RETURN writeLP(
    struct gmoRec* gmo,
    struct gevRec* gev,
+   const struct presolve_s* presolve,  /**< reductions to apply, or NULL */
+   const struct decomp_s* decomp,      /**< decomposition into blocks, or NULL */
+   int            block,               /**< block to write, if decomposition is given */
+   DECL_convertWriteFunc((*writefunc)),
+   void*          writedata
+);
+
+/** writes the current levels of all variables as a start solution in .mst format, one "name value" per line */
+extern
+RETURN writeMST(
+   struct gmoRec* gmo,
+   struct gevRec* gev,
+   const struct presolve_s* presolve,  /**< reductions whose removed variables are left out, or NULL */
+   const struct decomp_s* decomp,      /**< decomposition into blocks, or NULL */
+   int            block,               /**< block whose variables are written, if decomposition is given */
    DECL_convertWriteFunc((*writefunc)),
    void*          writedata
 );
@@ -0,0 +1,281 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "decomp.h"
+
+/** a connected component, as sorted for grouping into blocks */
+typedef struct
+{
+   int         id;           /**< number of component, in order of its first variable */
+   double      size;         /**< number of variables, rows, and nonzeros of component */
+   int         hasrows;      /**< whether component has a row */
+} component_t;
+
+/** finds the representative of the component of a variable, and shortens the path to it on the way */
+static
+int findroot(
+   int*        parent,
+   int         j
+)
+{
+   while( parent[j] != j )
+   {
+      parent[j] = parent[parent[j]];
+      j = parent[j];
+   }
+
+   return j;
+}
+
+/** joins the components of two variables, attaching the smaller one to the larger one */
+static
+void unite(
+   int*        parent,
+   int*        size,
+   int         i,
+   int         j
+)
+{
+   i = findroot(parent, i);
+   j = findroot(parent, j);
+
+   if( i == j )
+      return;
+
+   if( size[i] < size[j] )
+   {
+      int tmp = i;
+      i = j;
+      j = tmp;
+   }
+
+   parent[j] = i;
+   size[i] += size[j];
+}
+
+/** orders components by decreasing size, and by number for equal size */
+static
+int comparecomponents(
+   const void* a,
+   const void* b
+)
+{
+   const component_t* ca = (const component_t*) a;
+   const component_t* cb = (const component_t*) b;
+
+   if( ca->size != cb->size )
+      return ca->size > cb->size ? -1 : 1;
+   return ca->id - cb->id;
+}
+
+RETURN decompCreate(
+   decomp_t**         decomp,
+   const modelsnap_t* snap,
+   const int*         colremoved,
+   const int*         rowremoved,
+   int                maxblocks
+)
+{
+   decomp_t* d;
+   int* parent = NULL;
+   int* size = NULL;
+   int* compid = NULL;
+   int* compblock = NULL;
+   component_t* comps = NULL;
+   double* load = NULL;
+   RETURN rc = RETURN_ERROR;
+   int ncomps = 0;
+   int r;
+   int j;
+   int k;
+   int c;
+   int b;
+
+   assert(decomp != NULL);
+   assert(snap != NULL);
+   assert(maxblocks >= 1);
+
+   d = (decomp_t*) calloc(1, sizeof(decomp_t));
+   if( d == NULL )
+      return RETURN_ERROR;
+   *decomp = d;
+
+   d->n = snap->n;
+   d->m = snap->m;
+
+   /* allocate at least one element, so that NULL means out of memory */
+   d->colblock = (int*) malloc((snap->n + 1) * sizeof(int));
+   d->rowblock = (int*) malloc((snap->m + 1) * sizeof(int));
+   parent = (int*) malloc((snap->n + 1) * sizeof(int));
+   size = (int*) malloc((snap->n + 1) * sizeof(int));
+   compid = (int*) malloc((snap->n + 1) * sizeof(int));
+   comps = (component_t*) calloc(snap->n + 1, sizeof(component_t));
+   if( d->colblock == NULL || d->rowblock == NULL || parent == NULL || size == NULL || compid == NULL || comps == NULL )
+      goto TERMINATE;
+
+   for( j = 0; j < snap->n; ++j )
+   {
+      parent[j] = j;
+      size[j] = 1;
+   }
+
+   /* all variables of a row are in the same component */
+   for( r = 0; r < snap->m; ++r )
+   {
+      int first = -1;
+
+      if( rowremoved != NULL && rowremoved[r] )
+         continue;
+
+      for( k = snap->rowstart[r]; k < snap->rowstart[r+1]; ++k )
+      {
+         j = snap->colidx[k];
+         if( colremoved != NULL && colremoved[j] )
+            continue;
+         if( first < 0 )
+            first = j;
+         else
+            unite(parent, size, first, j);
+      }
+   }
+
+   /* number the components in order of their first variable */
+   for( j = 0; j < snap->n; ++j )
+   {
+      if( colremoved != NULL && colremoved[j] )
+         continue;
+      if( findroot(parent, j) == j )
+      {
+         compid[j] = ncomps;
+         comps[ncomps].id = ncomps;
+         ++ncomps;
+      }
+   }
+   for( j = 0; j < snap->n; ++j )
+      if( colremoved == NULL || !colremoved[j] )
+      {
+         compid[j] = compid[findroot(parent, j)];
+         comps[compid[j]].size += 1.0;
+      }
+   for( r = 0; r < snap->m; ++r )
+   {
+      int first = -1;
+      double nnz = 0.0;
+
+      if( rowremoved != NULL && rowremoved[r] )
+         continue;
+
+      for( k = snap->rowstart[r]; k < snap->rowstart[r+1]; ++k )
+         if( colremoved == NULL || !colremoved[snap->colidx[k]] )
+         {
+            if( first < 0 )
+               first = snap->colidx[k];
+            nnz += 1.0;
+         }
+
+      if( first >= 0 )
+      {
+         comps[compid[first]].size += 1.0 + nnz;
+         comps[compid[first]].hasrows = 1;
+      }
+   }
+
+   /* variables without rows are not worth a job of their own */
+   for( c = 0; c < ncomps; ++c )
+      if( comps[c].hasrows )
+         ++d->ncomponents;
+
+   d->nblocks = d->ncomponents < maxblocks ? d->ncomponents : maxblocks;
+   if( d->nblocks < 1 )
+      d->nblocks = 1;
+
+   d->ncols = (int*) calloc(d->nblocks, sizeof(int));
+   d->nrows = (int*) calloc(d->nblocks, sizeof(int));
+   d->nnz = (int*) calloc(d->nblocks, sizeof(int));
+   compblock = (int*) malloc((ncomps + 1) * sizeof(int));
+   load = (double*) calloc(d->nblocks, sizeof(double));
+   if( d->ncols == NULL || d->nrows == NULL || d->nnz == NULL || compblock == NULL || load == NULL )
+      goto TERMINATE;
+
+   /* largest component first into the block with least load, so that blocks get about equal sizes */
+   qsort(comps, ncomps, sizeof(component_t), comparecomponents);
+   for( c = 0; c < ncomps; ++c )
+   {
+      int best = 0;
+
+      if( !comps[c].hasrows )
+      {
+         compblock[comps[c].id] = 0;
+         continue;
+      }
+
+      for( b = 1; b < d->nblocks; ++b )
+         if( load[b] < load[best] )
+            best = b;
+
+      compblock[comps[c].id] = best;
+      load[best] += comps[c].size;
+   }
+
+   for( j = 0; j < snap->n; ++j )
+   {
+      if( colremoved != NULL && colremoved[j] )
+      {
+         d->colblock[j] = -1;
+         continue;
+      }
+      d->colblock[j] = compblock[compid[j]];
+      ++d->ncols[d->colblock[j]];
+   }
+
+   for( r = 0; r < snap->m; ++r )
+   {
+      if( rowremoved != NULL && rowremoved[r] )
+      {
+         d->rowblock[r] = -1;
+         continue;
+      }
+
+      d->rowblock[r] = 0;
+      for( k = snap->rowstart[r]; k < snap->rowstart[r+1]; ++k )
+         if( d->colblock[snap->colidx[k]] >= 0 )
+         {
+            d->rowblock[r] = d->colblock[snap->colidx[k]];
+            ++d->nnz[d->rowblock[r]];
+         }
+      ++d->nrows[d->rowblock[r]];
+   }
+
+   rc = RETURN_OK;
+
+TERMINATE:
+   free(parent);
+   free(size);
+   free(compid);
+   free(comps);
+   free(compblock);
+   free(load);
+
+   if( rc != RETURN_OK )
+      decompFree(decomp);
+
+   return rc;
+}
+
+void decompFree(
+   decomp_t** decomp
+)
+{
+   assert(decomp != NULL);
+
+   if( *decomp == NULL )
+      return;
+
+   free((*decomp)->colblock);
+   free((*decomp)->rowblock);
+   free((*decomp)->ncols);
+   free((*decomp)->nrows);
+   free((*decomp)->nnz);
+   free(*decomp);
+   *decomp = NULL;
+}
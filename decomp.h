@@ -0,0 +1,45 @@
+#ifndef DECOMP_H_
+#define DECOMP_H_
+
+#include "convert.h"  /* for RETURN */
+#include "modelsnap.h"
+
+/** a partition of a model into blocks that share no rows
+ *
+ * The connected components of the graph of variables and rows, with an edge for each nonzero of the matrix,
+ * are found by union-find over the variables. If there are more components than blocks allowed,
+ * the components are grouped into blocks, each taken by the block with the least nonzeros so far, largest component first.
+ */
+typedef struct decomp_s
+{
+   int         n;            /**< number of variables */
+   int         m;            /**< number of rows */
+   int         ncomponents;  /**< number of connected components that have rows */
+   int         nblocks;      /**< number of blocks */
+   int*        colblock;     /**< block of each variable, or -1 if it has been removed */
+   int*        rowblock;     /**< block of each row, or -1 if it has been removed */
+   int*        ncols;        /**< number of variables in each block */
+   int*        nrows;        /**< number of rows in each block */
+   int*        nnz;          /**< number of nonzeros in each block */
+} decomp_t;
+
+/** finds the connected components of a model and groups them into at most maxblocks blocks
+ *
+ * Variables and rows that have been removed by a presolve are ignored.
+ * Variables without rows and rows without variables are put into block 0.
+ */
+extern
+RETURN decompCreate(
+   decomp_t**         decomp,
+   const modelsnap_t* snap,
+   const int*         colremoved, /**< whether a variable has been removed, or NULL */
+   const int*         rowremoved, /**< whether a row has been removed, or NULL */
+   int                maxblocks
+);
+
+extern
+void decompFree(
+   decomp_t** decomp
+);
+
+#endif /* DECOMP_H_ */
@@ -0,0 +1,27 @@
+#ifndef FASTFLOAT_H_
+#define FASTFLOAT_H_
+
+#include <stddef.h>
+
+/** longest number that is parsed, as cJSON did before */
+#define FASTFLOAT_MAXLEN 63
+
+/** parses a number from a JSON document, independent of the current locale
+ *
+ * Considers the longest prefix of str that consists of the characters 0-9, +, -, ., e, E,
+ * but at most FASTFLOAT_MAXLEN characters, and reads from it what strtod() in the C locale would read.
+ * The result is exactly the one of strtod(), i.e., the correctly rounded double.
+ *
+ * Numbers in the usual JSON format with at most 19 significant digits are converted without calling strtod(),
+ * using Clinger's fast path or the Eisel-Lemire algorithm. Other numbers are passed on to strtod().
+ *
+ * @return number of characters read, or 0 if there is no number
+ */
+extern
+size_t fastfloatParse(
+   const char* str,
+   size_t      length,      /**< number of characters available in str */
+   double*     value
+);
+
+#endif /* FASTFLOAT_H_ */
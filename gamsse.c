@@ -11,17 +11,20 @@
 #include <string.h>
 #include <ctype.h>  /* for tolower() */
 #include <assert.h>
+#include <math.h>  /* for isfinite(), isnan(), fabs(), fmax() */
+#include <time.h>
 #ifndef _WIN32
-#include <unistd.h>  /* for sleep() */
-#endif
-#if 0
-#include <time.h>  /* for strptime */
+#include <pthread.h>
+#include <unistd.h>
+#include <strings.h>  /* for strncasecmp() and strcasecmp() */
 #endif
 
 #ifdef _WIN32
 #define timegm _mkgmtime
 #define snprintf _snprintf
 #define strdup _strdup
+#define strncasecmp _strnicmp
+#define strcasecmp _stricmp
 #endif
 
 #include "curl/curl.h"  /* this seems to include some windows headers so that Sleep() becomes available */
@@ -35,6 +38,19 @@
 #include "palmcc.h"
 
 #include "convert.h"
+#include "decomp.h"
+#include "localsolve.h"
+#include "transfer.h"
+#include "metrics.h"
+#include "modeldelta.h"
+#include "modelsnap.h"
+#include "presolve.h"
+#include "resultcache.h"
+#include "scenario.h"
+#include "solreader.h"
+
+#define DELTAMAXFRACTION 0.25  /**< maximal fraction of entries of vectors that may have changed for sending only the changes of a model */
+#define LOCALPOLLINTERVAL 0.01 /**< time in seconds between checks whether the local solver has finished */
 
 typedef struct
 {
@@ -51,20 +67,192 @@ struct gamsse_s
    gevHandle_t gev;
    optHandle_t opt;
    char*       apikey;
-   char*       jobid;
+   char        apiurl[GMS_SSSIZE]; /**< base URL of the API, without trailing slash */
+   int         apiextensions; /**< whether the API implements resumable uploads and problems that refer to earlier ones, which SolveEngine does not */
    int         debug;
    int         verifycert;
    double      hardtimelimit;
+   int         maxretries;    /**< maximal number of retries of a request after a transient failure */
+   size_t      uploadchunksize; /**< size of chunks for uploading large problems, or 0 to upload in a single request */
+   int         streamresults; /**< whether to parse results while they are downloaded */
+   int         compression;   /**< whether to accept compressed responses */
+   size_t      indexthreshold; /**< size of downloaded results above which they are read via a structural index instead of cJSON, or 0 */
+   int         indexthreads;  /**< number of threads that convert variables of results that are read via a structural index */
+   int         checksolution; /**< whether to check the solution for violated bounds and rows */
+   double      checktol;      /**< tolerance for counting violated bounds and rows */
+   int         checkthreads;  /**< number of threads for checking the solution */
+   modelsnap_t* modelsnap;    /**< snapshot of instance, or NULL if not taken yet */
+   modeldelta_t* modeldelta;  /**< vectors of instance for incremental submission, or NULL if not used */
+   presolve_t* presolve;      /**< reductions applied to the submitted problem, or NULL if not used */
+   decomp_t*   decomp;        /**< independent blocks of instance that are submitted as jobs of their own, or NULL if not used */
+   char*       solveroptions; /**< solver parameters as JSON object for the options of a job */
+   char**      raceoptions;   /**< options of the jobs that race on the same problem, as JSON objects */
+   int         nraceoptions;  /**< number of jobs that race on the same problem, or 0 to submit a single job */
+   int         uploadconnections; /**< maximal number of connections for uploading chunks in parallel */
+   double      retrydelay;    /**< delay before first retry, doubled for each further retry */
+   double      retrymaxdelay; /**< maximal delay between retries */
+   double      stopgap;       /**< relative gap at which a running job is stopped, or 0 */
+   double      stopnoimprove; /**< time without change of incumbent after which a running job is stopped, or 0 */
+   resultcache_t* cache;      /**< cache of results of earlier jobs, or NULL */
+   char        cachekey[RESULTCACHE_KEYLENGTH+1]; /**< key of problem in result cache */
 
    CURL*       curl;
    char        curlerrbuf[CURL_ERROR_SIZE];   /**< buffer for curl to store error message */
    struct curl_slist* curlheaders;
    buffer_t    curlwritebuf;
+   metrics_t*  metrics;       /**< timing statistics of all requests */
+
+   CURLSH*     curlshare;     /**< connections, DNS cache, and TLS sessions shared by all our curl handles */
+#ifndef _WIN32
+   pthread_mutex_t curlsharelocks[CURL_LOCK_DATA_LAST];
+#endif
+
+#ifndef _WIN32
+   pthread_t   prewarmthread; /**< thread that opens the connection to SolveEngine while the problem is converted */
+#endif
+   int         prewarming;    /**< whether prewarmthread has been started and not joined yet */
+   CURLcode    prewarmres;    /**< transfer result of prewarming request */
+   long        prewarmrespcode; /**< HTTP response code of prewarming request */
+   double      prewarmsetup;  /**< time spent in prewarming request for setting up the connection */
+   double      prewarmtotal;  /**< total time of prewarming request */
+};
+
+/** phases of a job that is run by runjobs() */
+typedef enum
+{
+   JOBPHASE_SUBMIT = 0,   /**< problem needs to be submitted, or upload session needs to be opened */
+   JOBPHASE_UPLOAD,       /**< chunks of problem need to be uploaded */
+   JOBPHASE_COMMIT,       /**< upload session needs to be turned into a job */
+   JOBPHASE_SCHEDULE,     /**< job needs to be scheduled */
+   JOBPHASE_POLL,         /**< waiting for job to finish */
+   JOBPHASE_RESULTS,      /**< results need to be retrieved */
+   JOBPHASE_DONE          /**< nothing more to do for this job */
+} JOBPHASE;
+
+/** status of a job as reported by SolveEngine */
+typedef enum
+{
+   JOBSTATUS_UNKNOWN = 0, /**< status not known yet or not in response */
+   JOBSTATUS_CREATED,
+   JOBSTATUS_QUEUED,
+   JOBSTATUS_TRANSLATING,
+   JOBSTATUS_STARTING,
+   JOBSTATUS_STARTED,
+   JOBSTATUS_COMPLETED,
+   JOBSTATUS_FAILED,
+   JOBSTATUS_TIMEOUT,
+   JOBSTATUS_OTHER        /**< a status that we do not know about */
+} JOBSTATUS;
+
+/** stop rules of the link by which a running job can be stopped */
+typedef enum
+{
+   JOBSTOP_NONE = 0,      /**< job has not been stopped by the link */
+   JOBSTOP_GAP,           /**< gap of incumbent is small enough */
+   JOBSTOP_NOIMPROVE      /**< incumbent did not improve for too long */
+} JOBSTOP;
+
+typedef struct upload_s upload_t;
+typedef struct backend_s backend_t;
+
+/** a SolveEngine job
+ *
+ * Each job has its own curl handle, so that uploads, status polls, and result downloads
+ * of many jobs can be run concurrently by runjobs().
+ */
+typedef struct sejob_s
+{
+   gamsse_t*   se;
+   const char* name;          /**< name of job for log, or NULL if there is only one job */
+   int         block;         /**< block of instance that the job solves, or -1 if it solves the complete instance */
+   const backend_t* backend;  /**< backend that solves the job */
+   buffer_t*   problem;       /**< body of submit request, not owned by job */
+   const struct sejob_s* dependson; /**< job whose problem the problem of this job refers to, so it is submitted once that job has been created, or NULL */
+   upload_t*   upload;        /**< state of chunked upload, or NULL if problem is submitted with a single request */
+   localsolve_t* local;       /**< process of local solver, or NULL if job is not solved locally */
+   char*       jobid;
+   JOBSTATUS   status;        /**< job status as last reported by SolveEngine */
+   cJSON*      results;       /**< results as retrieved from SolveEngine, or NULL */
+   solreader_t* solreader;    /**< reader for results that are parsed while downloading or via a structural index, or NULL */
+   int         resultsread;   /**< whether solreader has read complete results */
+   JOBPHASE    phase;
+   int         busy;          /**< number of requests for this job that are in flight */
+   int         pollsetup;     /**< whether curl handle is still set up for the status poll */
+   double      starttime;     /**< time when job has been scheduled */
+   int         hasincumbent;  /**< whether SolveEngine reported the objective value of an incumbent */
+   double      incumbent;     /**< objective value of incumbent as last reported */
+   double      bound;         /**< bound on objective value as last reported, or NAN */
+   double      gap;           /**< relative gap as last reported or computed from incumbent and bound, or NAN */
+   double      lastimprove;   /**< time when incumbent changed last, or when job has been scheduled */
+   JOBSTOP     stop;          /**< stop rule that applied to job, or JOBSTOP_NONE */
+   int         stopsent;      /**< whether job has been stopped at SolveEngine */
+   double      nextrequest;   /**< time when to send next request: next status poll or retry */
+   int         retries;       /**< number of retries of current request */
+   char        idempotencykey[40]; /**< key that allows SolveEngine to recognize repeated submissions */
+   struct curl_slist* submitheaders; /**< http header for submit request, includes idempotency key */
+
+   CURL*       curl;
+   char        curlerrbuf[CURL_ERROR_SIZE];   /**< buffer for curl to store error message */
+   buffer_t    curlwritebuf;
 
    double      progresslastruntime;
    int         progressisupload;
+} sejob_t;
+
+/** a backend that solves jobs
+ *
+ * runjobs() calls the function for the phase of a job whenever the job is not busy and its next request is due.
+ * The function may finish asynchronously via the transfer engine, and moves the job into its next phase.
+ */
+struct backend_s
+{
+   const char* name;
+   RETURN    (*submit)(transfer_t* tr, sejob_t* job);  /**< starts solving the problem of a job, until the job is in JOBPHASE_POLL */
+   RETURN    (*status)(transfer_t* tr, sejob_t* job);  /**< checks whether a job in JOBPHASE_POLL is still running */
+   RETURN    (*results)(transfer_t* tr, sejob_t* job); /**< retrieves the results of a job in JOBPHASE_RESULTS */
+   void      (*stop)(sejob_t* job);                    /**< stops a running job */
+};
+
+/** a connection that uploads chunks of a problem */
+typedef struct
+{
+   sejob_t*    job;
+   int         chunk;         /**< chunk that is currently uploaded, or -1 */
+   CURL*       curl;
+   char        curlerrbuf[CURL_ERROR_SIZE];
+   buffer_t    curlwritebuf;
+   struct curl_slist* headers; /**< http header for chunk request, includes content range */
+} uploadslot_t;
+
+/** state of a resumable upload
+ *
+ * A large problem is uploaded in chunks into an upload session.
+ * Chunks are sent via several connections in parallel and each chunk is acknowledged separately,
+ * so after a failure only the chunks that have not been acknowledged are sent again.
+ * When all chunks have arrived, the session is committed, which creates the job.
+ */
+struct upload_s
+{
+   char*         sessionid;
+   size_t        chunksize;
+   int           nchunks;
+   int           nchunksdone;
+   char*         chunkstate;  /**< for each chunk, 0 if missing, 1 if in flight, 2 if acknowledged */
+   int*          chunkretries;/**< for each chunk, number of failed attempts to upload it */
+   int           nextchunk;   /**< chunk to consider next when looking for a chunk to upload */
+   int           failed;      /**< whether upload of some chunk failed permanently */
+   uploadslot_t* slots;
+   int           nslots;
+   transfer_t*   tr;          /**< transfer engine that runs the chunk uploads */
+   char          request[64]; /**< body of request to open upload session */
 };
 
+/** names of job phases, as used in statistics */
+static const char* jobphasename[] = { "submit", "chunk", "commit", "schedule", "status", "results", "done" };
+
+/** names of job status, as used by SolveEngine */
+static const char* jobstatusname[] = { "UNKNOWN", "created", "queued", "translating", "starting", "started", "completed", "failed", "timeout", "OTHER" };
+
 /** struct for writing problem into base64-encoded string */
 typedef struct
 {
@@ -88,9 +276,22 @@ typedef struct
       } \
    } while( 0 )
 
+/* sleeps for a given number of seconds */
+static
+void sleepsec(
+   double sec
+)
+{
 #ifdef _WIN32
-void sleep(int sec) { Sleep(sec*1000); }
+   Sleep((DWORD)(sec * 1000));
+#else
+   struct timespec ts;
+
+   ts.tv_sec = (time_t)sec;
+   ts.tv_nsec = (long)((sec - ts.tv_sec) * 1e9);
+   nanosleep(&ts, NULL);
 #endif
+}
 
 /* like strcasestr, but assumes needle to be in lower-case */
 static
@@ -225,7 +426,31 @@ DECL_convertWriteFunc(appendbufferConvert)
    return msglen;
 }
 
-/* CURLOPT_XFERINFOFUNCTION callback to print progress report */
+/** appendbuffer function for use in convert, without encoding */
+static
+DECL_convertWriteFunc(appendbufferWrite)
+{
+   assert(msg != NULL);
+   assert(writedata != NULL);
+
+   return appendbuffer((buffer_t*)writedata, (char*)msg);
+}
+
+/** write function for use in convert, into a file */
+static
+DECL_convertWriteFunc(writefile)
+{
+   size_t msglen;
+
+   assert(msg != NULL);
+   assert(writedata != NULL);
+
+   msglen = strlen(msg);
+
+   return fwrite(msg, 1, msglen, (FILE*)writedata) == msglen ? msglen : 0;
+}
+
+/* CURLOPT_XFERINFOFUNCTION callback to print progress report of a job */
 static int progressreportCurl(
    void*      p,
    curl_off_t dltotal,
@@ -234,21 +459,25 @@ static int progressreportCurl(
    curl_off_t ulnow
    )
 {
-   gamsse_t* se = (gamsse_t*) p;
+   sejob_t* job = (sejob_t*) p;
+   gamsse_t* se;
    double curtime = 0.0;
    char buf[GMS_SSSIZE];
 
-   assert(se!= NULL);
+   assert(job != NULL);
+   se = job->se;
+   assert(se != NULL);
 
-   CURL_CHECK( se, curl_easy_getinfo(se->curl, CURLINFO_TOTAL_TIME, &curtime) );
+   CURL_CHECK( se, curl_easy_getinfo(job->curl, CURLINFO_TOTAL_TIME, &curtime) );
 
    /* don't print if less than 1 second passed since last print */
-   if( (curtime - se->progresslastruntime) < 1.0 )
+   if( (curtime - job->progresslastruntime) < 1.0 )
       return 0;
-   se->progresslastruntime = curtime;
+   job->progresslastruntime = curtime;
 
-   sprintf(buf, "%6.1fs: %" CURL_FORMAT_CURL_OFF_T " of %" CURL_FORMAT_CURL_OFF_T " bytes %s\n", curtime,
-      se->progressisupload ? ulnow : dlnow, se->progressisupload ? ultotal : dltotal, se->progressisupload ? "uploaded" : "downloaded");
+   sprintf(buf, "%6.1fs: %s%s%" CURL_FORMAT_CURL_OFF_T " of %" CURL_FORMAT_CURL_OFF_T " bytes %s\n", curtime,
+      job->name != NULL ? job->name : "", job->name != NULL ? ": " : "",
+      job->progressisupload ? ulnow : dlnow, job->progressisupload ? ultotal : dltotal, job->progressisupload ? "uploaded" : "downloaded");
    gevLogPChar(se->gev, buf);
 
    /* stop curl if user interrupt */
@@ -310,6 +539,35 @@ char* formattime(
    return buf;
 }
 
+#ifndef _WIN32
+/* CURLSHOPT_LOCKFUNC callback */
+static
+void lockCurlShare(
+   CURL*            handle,
+   curl_lock_data   data,
+   curl_lock_access access,
+   void*            userptr
+   )
+{
+   gamsse_t* se = (gamsse_t*) userptr;
+
+   pthread_mutex_lock(&se->curlsharelocks[data]);
+}
+
+/* CURLSHOPT_UNLOCKFUNC callback */
+static
+void unlockCurlShare(
+   CURL*            handle,
+   curl_lock_data   data,
+   void*            userptr
+   )
+{
+   gamsse_t* se = (gamsse_t*) userptr;
+
+   pthread_mutex_unlock(&se->curlsharelocks[data]);
+}
+#endif
+
 static
 RETURN initCurl(
    gamsse_t* se
@@ -317,6 +575,9 @@ RETURN initCurl(
 {
    RETURN rc = RETURN_ERROR;
    char buffer[100];
+#ifndef _WIN32
+   int i;
+#endif
 
    assert(se->apikey != NULL);
    assert(se->curl == NULL);
@@ -335,45 +596,75 @@ RETURN initCurl(
    se->curlheaders = curl_slist_append(NULL, buffer);
    assert(se->curlheaders != NULL);
 
+   /* create share object, so that all our handles can reuse a connection that has been opened by any of them */
+   se->curlshare = curl_share_init();
+   if( se->curlshare == NULL )
+   {
+      gevLogStat(se->gev, "Error in curl_share_init()\n");
+      goto TERMINATE;
+   }
+#ifndef _WIN32
+   for( i = 0; i < CURL_LOCK_DATA_LAST; ++i )
+      pthread_mutex_init(&se->curlsharelocks[i], NULL);
+   curl_share_setopt(se->curlshare, CURLSHOPT_LOCKFUNC, lockCurlShare);
+   curl_share_setopt(se->curlshare, CURLSHOPT_UNLOCKFUNC, unlockCurlShare);
+   curl_share_setopt(se->curlshare, CURLSHOPT_USERDATA, se);
+#endif
+   curl_share_setopt(se->curlshare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+   curl_share_setopt(se->curlshare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+   curl_share_setopt(se->curlshare, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+
    rc = RETURN_OK;
 TERMINATE:
    return rc;
 }
 
+/** resets a curl handle and sets the options that all our requests have in common */
 static
-RETURN resetCurl(
-   gamsse_t* se
+RETURN setupCurl(
+   gamsse_t* se,
+   CURL*     curl,
+   char*     errbuf,     /**< buffer of size CURL_ERROR_SIZE to store error message */
+   buffer_t* writebuf    /**< buffer to store response */
 )
 {
    RETURN rc = RETURN_ERROR;
 
    assert(se != NULL);
-   assert(se->curl != NULL);
+   assert(curl != NULL);
    assert(se->curlheaders != NULL);
 
    /* reset all options */
-   curl_easy_reset(se->curl);
+   curl_easy_reset(curl);
 
    /* set error buffer */
-   *se->curlerrbuf = '\0';
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_ERRORBUFFER, se->curlerrbuf) );
+   *errbuf = '\0';
+   CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errbuf) );
 
    if( se->debug >= 2 )
    {
       /* enable curl verbose output */
-      CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_VERBOSE, 1) );
+      CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L) );
    }
 
    /* set write buffer */
-   se->curlwritebuf.length = 0;
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_WRITEFUNCTION, appendbufferCurl) );
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_WRITEDATA, &se->curlwritebuf) );
+   writebuf->length = 0;
+   CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, appendbufferCurl) );
+   CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_WRITEDATA, writebuf) );
 
    /* set http header (api key) */
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_HTTPHEADER, se->curlheaders) );
+   CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_HTTPHEADER, se->curlheaders) );
+
+   /* offer all encodings that libcurl supports (e.g., gzip, deflate, zstd); responses are decompressed as they arrive, before they reach the write function */
+   if( se->compression )
+      CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "") );
 
    if( !se->verifycert )
-      CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_SSL_VERIFYPEER, 0) );
+      CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L) );
+
+   /* reuse connections of other handles */
+   if( se->curlshare != NULL )
+      CURL_CHECK( se, curl_easy_setopt(curl, CURLOPT_SHARE, se->curlshare) );
 
    rc = RETURN_OK;
 TERMINATE:
@@ -381,9 +672,25 @@ TERMINATE:
 }
 
 static
-RETURN performCurl(
+RETURN resetCurl(
+   gamsse_t* se
+)
+{
+   assert(se != NULL);
+   assert(se->curl != NULL);
+
+   return setupCurl(se, se->curl, se->curlerrbuf, &se->curlwritebuf);
+}
+
+/** evaluates the outcome of a finished request: transfer result, HTTP response code, and optionally parses the response */
+static
+RETURN evalCurl(
    gamsse_t* se,
-   cJSON**   json
+   CURL*     curl,
+   CURLcode  curlres,    /**< result of transfer */
+   char*     errbuf,     /**< error buffer of curl handle */
+   buffer_t* writebuf,   /**< buffer that holds response */
+   cJSON**   json        /**< buffer to store parsed response, or NULL if response should not be parsed */
 )
 {
    RETURN rc = RETURN_ERROR;
@@ -392,13 +699,20 @@ RETURN performCurl(
    if( json != NULL )
       *json = NULL;
 
-   /* perform HTTP request */
-   CURL_CHECK( se, curl_easy_perform(se->curl) );
+   if( curlres != CURLE_OK )
+   {
+      gevLogStatPChar(se->gev, "libcurl: ");
+      if( *errbuf != '\0' )
+         gevLogStat(se->gev, errbuf);
+      else
+         gevLogStat(se->gev, curl_easy_strerror(curlres));
+      goto TERMINATE;
+   }
 
    if( se->debug )
    {
       char* url = NULL;
-      CURL_CHECK( se, curl_easy_getinfo(se->curl, CURLINFO_EFFECTIVE_URL, &url) );
+      CURL_CHECK( se, curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url) );
       if( url != NULL )
       {
          gevLogPChar(se->gev, "DEBUG Connected to ");
@@ -407,24 +721,26 @@ RETURN performCurl(
       }
    }
 
-   if( se->curlwritebuf.content == NULL )  /* got no output at all */
+   if( writebuf->length == 0 && json != NULL )  /* got no output at all */
    {
       gevLogStat(se->gev, "Failure in connection from SolveEngine: Response is empty.");
       goto TERMINATE;
    }
 
    /* add terminating \0 */
-   ((char*)se->curlwritebuf.content)[se->curlwritebuf.length] = '\0';
+   if( ensurebuffer(writebuf, 1) < 1 )
+      goto TERMINATE;
+   ((char*)writebuf->content)[writebuf->length] = '\0';
 
    if( se->debug )
    {
       gevLogPChar(se->gev, "DEBUG Answer from SolveEngine: ");
-      gevLogPChar(se->gev, (char*)se->curlwritebuf.content);
+      gevLogPChar(se->gev, (char*)writebuf->content);
       gevLogPChar(se->gev, "\n");
    }
 
    /* check HTTP response code */
-   CURL_CHECK( se, curl_easy_getinfo(se->curl, CURLINFO_RESPONSE_CODE, &respcode) );
+   CURL_CHECK( se, curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &respcode) );
    if( se->debug )
    {
       char buffer[GMS_SSSIZE];
@@ -435,18 +751,18 @@ RETURN performCurl(
    if( respcode >= 400 )
    {
       gevLogStat(se->gev, "Failure from SolveEngine:");
-      gevLogStatPChar(se->gev, se->curlwritebuf.content);
+      gevLogStatPChar(se->gev, writebuf->content);
       goto TERMINATE;
    }
 
    if( json != NULL )
    {
       /* parse response */
-      *json = cJSON_Parse((char*)se->curlwritebuf.content);
+      *json = cJSON_Parse((char*)writebuf->content);
       if( *json == NULL )
       {
          gevLogStatPChar(se->gev, "Failure parsing SolveEngine response. Content: ");
-         gevLogStatPChar(se->gev, se->curlwritebuf.content);
+         gevLogStatPChar(se->gev, writebuf->content);
          gevLogStatPChar(se->gev, "\n");
          goto TERMINATE;
       }
@@ -457,503 +773,3780 @@ TERMINATE:
    return rc;
 }
 
+/** checks whether a request failed for a reason that may go away when trying again */
+static
+int istransient(
+   CURL*     curl,
+   CURLcode  curlres
+)
+{
+   long respcode = 0;
+
+   switch( curlres )
+   {
+      case CURLE_OK :
+         break;
+      case CURLE_COULDNT_RESOLVE_HOST :
+      case CURLE_COULDNT_CONNECT :
+      case CURLE_OPERATION_TIMEDOUT :
+      case CURLE_SSL_CONNECT_ERROR :
+      case CURLE_SEND_ERROR :
+      case CURLE_RECV_ERROR :
+      case CURLE_GOT_NOTHING :
+      case CURLE_PARTIAL_FILE :
+      case CURLE_HTTP2 :
+      case CURLE_HTTP2_STREAM :
+         return 1;
+      default :
+         return 0;
+   }
+
+   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &respcode);
+
+   /* request timeout, too many requests, bad gateway, service unavailable, gateway timeout */
+   return respcode == 408 || respcode == 429 || respcode == 502 || respcode == 503 || respcode == 504;
+}
 
+/** gives delay before a retry: exponential backoff, capped by option retrymaxdelay */
 static
-void printjoblist(
-   gamsse_t* se
+double retrybackoff(
+   gamsse_t* se,
+   int       retry       /**< number of retry, starting at 1 */
 )
 {
-   gevHandle_t gev = se->gev;
-   char strbuffer[1024];
-   cJSON* root = NULL;
-   cJSON* jobs = NULL;
-   cJSON* total = NULL;
-   int j;
+   double delay;
 
-   if( resetCurl(se) != RETURN_OK )
-      goto TERMINATE;
+   delay = se->retrydelay;
+   while( --retry > 0 && delay < se->retrymaxdelay )
+      delay *= 2.0;
 
-   /* set URL */
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, "https://solve.satalia.com/api/v2/jobs?per_page=2147483647") );
+   return delay < se->retrymaxdelay ? delay : se->retrymaxdelay;
+}
 
-   /* perform HTTP request */
-   if( performCurl(se, &root) != RETURN_OK )
-      goto TERMINATE;
-   assert(root != NULL);
+/** logs that a request is retried */
+static
+void logretry(
+   gamsse_t*   se,
+   CURL*       curl,
+   CURLcode    curlres,
+   const char* request,
+   int         retry,
+   double      delay
+)
+{
+   char buffer[GMS_SSSIZE];
+   long respcode = 0;
 
-   total = cJSON_GetObjectItem(root, "total");
-   if( total == NULL || !cJSON_IsNumber(total) )
-      gevLogPChar(gev, "Printing Joblist:\n");
+   if( curlres != CURLE_OK )
+      sprintf(buffer, "Request %s failed (%s). Retry %d of %d in %.1fs.", request, curl_easy_strerror(curlres), retry, se->maxretries, delay);
    else
    {
-      sprintf(strbuffer, "Printing Joblist: %d jobs in total\n", total->valueint);
-      gevLogPChar(gev, strbuffer);
-
-      if( total->valueint == 0 )
-         goto TERMINATE;
+      curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &respcode);
+      sprintf(buffer, "Request %s failed (HTTP response code %ld). Retry %d of %d in %.1fs.", request, respcode, retry, se->maxretries, delay);
    }
+   gevLog(se->gev, buffer);
+}
+
+/** performs a blocking request with the curl handle of se
+ *
+ * If the request is idempotent, then it is repeated after transient failures.
+ */
+static
+RETURN performCurl(
+   gamsse_t*   se,
+   const char* request,  /**< kind of request, for statistics */
+   const char* jobid,    /**< job that request belongs to, or NULL */
+   int         idempotent, /**< whether request can safely be repeated */
+   cJSON**     json
+)
+{
+   CURLcode curlres;
+   int retry = 0;
 
-   jobs = cJSON_GetObjectItem(root, "jobs");
-   if( jobs == NULL || !cJSON_IsArray(jobs) )
+   for( ;; )
    {
-      gevLogStat(gev, "printjoblist: No 'jobs' found in answer from SolveEngine.");
-      goto TERMINATE;
-   }
+      /* perform HTTP request */
+      *se->curlerrbuf = '\0';
+      se->curlwritebuf.length = 0;
+      curlres = curl_easy_perform(se->curl);
 
-   sprintf(strbuffer, "%40s %5s %10s %30s %30s %30s Used\n",
-      "Job ID", "Algo", "Status", "Submittime", "Starttime", "Finishtime");
-   gevLogPChar(gev, strbuffer);
+      if( se->metrics != NULL )
+         metricsAddRequest(se->metrics, se->curl, request, jobid, retry, curlres, se->curlwritebuf.length);
 
-   for( j = 0; j < cJSON_GetArraySize(jobs); ++j )
-   {
-      cJSON* job;
-      cJSON* id;
-      cJSON* status;
-      cJSON* algo;
-      cJSON* submitted;
-      cJSON* started;
-      cJSON* finished;
-      cJSON* usedtime;
-      char submittedbuf[32];
-      char startedbuf[32];
-      char finishedbuf[32];
-      job = cJSON_GetArrayItem(jobs, j);
-      assert(job != NULL);
-
-      id = cJSON_GetObjectItem(job, "id");
-      if( id == NULL )
-         continue;
+      if( !idempotent || retry >= se->maxretries || !istransient(se->curl, curlres) )
+         break;
 
-      status = cJSON_GetObjectItem(job, "status");
-      algo = cJSON_GetObjectItem(job, "algorithm");
-      submitted = cJSON_GetObjectItem(job, "submitted");
-      started = cJSON_GetObjectItem(job, "started");
-      finished = cJSON_GetObjectItem(job, "finished");
-      usedtime = cJSON_GetObjectItem(job, "used_time");
-
-      sprintf(strbuffer, "%s %5s %10s %30s %30s %30s %4d\n",
-         id->valuestring,
-         algo != NULL ? algo->valuestring : "N/A",
-         status != NULL ? status->valuestring : "N/A",
-         formattime(submittedbuf, submitted != NULL ? submitted->valuestring : NULL),
-         formattime(startedbuf, started != NULL ? started->valuestring : NULL),
-         formattime(finishedbuf, finished != NULL ? finished->valuestring : NULL),
-         usedtime ? usedtime->valueint : 0
-      );
-      gevLogPChar(gev, strbuffer);
+      ++retry;
+      logretry(se, se->curl, curlres, request, retry, retrybackoff(se, retry));
+      sleepsec(retrybackoff(se, retry));
    }
 
-TERMINATE :
-   if( root != NULL )
-      cJSON_Delete(root);
+   return evalCurl(se, se->curl, curlres, se->curlerrbuf, &se->curlwritebuf, json);
 }
 
-/* returns job id */
+#ifndef _WIN32
+/** thread that sends a cheap authenticated request to SolveEngine
+ *
+ * This sets up DNS, TCP, and TLS for the connection while the main thread is converting the problem,
+ * so that the upload can start on an open connection.
+ * Does not log, as gev should only be used from the main thread.
+ */
 static
-RETURN submitjob(
-   gamsse_t* se
+void* prewarmCurl(
+   void* p
    )
 {
-   gevHandle_t gev = se->gev;
-   gmoHandle_t gmo = se->gmo;
-   cJSON* root = NULL;
-   cJSON* id = NULL;
-   char* postfields = NULL;
-   encodeprob_t encodeprob = { .buffer = BUFFERINIT };
-   RETURN rc = RETURN_ERROR;
-   RETURN rc_writelp;
-   int timelimit;
-   char strbuffer[GMS_SSSIZE];
+   gamsse_t* se = (gamsse_t*) p;
+   CURL* curl;
+   char errbuf[CURL_ERROR_SIZE];
+   char url[GMS_SSSIZE+32];
+   buffer_t writebuf = BUFFERINIT;
+   curl_off_t setuptime = 0;
+   curl_off_t totaltime = 0;
+
+   curl = curl_easy_init();
+   if( curl == NULL )
+   {
+      se->prewarmres = CURLE_FAILED_INIT;
+      return NULL;
+   }
 
-   assert(se->jobid == NULL);
+   curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errbuf);
+   snprintf(url, sizeof(url), "%s/jobs?per_page=1", se->apiurl);
+   curl_easy_setopt(curl, CURLOPT_URL, url);
+   curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, appendbufferCurl);
+   curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writebuf);
+   curl_easy_setopt(curl, CURLOPT_HTTPHEADER, se->curlheaders);
+   curl_easy_setopt(curl, CURLOPT_SHARE, se->curlshare);
+   if( !se->verifycert )
+      curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
 
-   /* SolveEngine time limit must be integer and >= 60 */
-   timelimit = (int)gevGetDblOpt(se->gev, gevResLim);
-   if( timelimit < 60 )
+   se->prewarmres = curl_easy_perform(curl);
+   if( se->prewarmres == CURLE_OK )
    {
-      gevLog(gev, "SolveEngine requires a time limit (reslim) of at least 60 seconds.");
-      timelimit = 60;
+      /* time until TLS handshake completed, or until connected if there is no TLS */
+      curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &setuptime);
+      if( setuptime == 0 )
+         curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &setuptime);
+      curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &totaltime);
+      curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &se->prewarmrespcode);
    }
+   se->prewarmsetup = setuptime / 1e6;
+   se->prewarmtotal = totaltime / 1e6;
 
-   sprintf(strbuffer, "Submitting Job with %d seconds time limit.", timelimit);
-   gevLog(gev, strbuffer);
-
-   if( resetCurl(se) != RETURN_OK )
-      goto TERMINATE;
+   curl_easy_cleanup(curl);
+   exitbuffer(&writebuf);
 
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, "https://solve.satalia.com/api/v2/jobs") );
+   return NULL;
+}
+#endif
 
-   /* post fields */
-   appendbuffer(&encodeprob.buffer, "{\"options\":{},\"problems\":[{\"name\":\"problem.lp\",\"data\": \"");
-   assert(encodeprob.buffer.length > 0);
+/** starts opening the connection to SolveEngine in a background thread
+ *
+ * Does nothing on Windows, where there are no POSIX threads, so that the first request opens the connection.
+ */
+static
+void startprewarm(
+   gamsse_t* se
+   )
+{
+   assert(!se->prewarming);
+   assert(se->curlshare != NULL);
 
-   /* append base64 encode of string in LP format (this will not be 0-terminated) */
-   base64_init_encodestate(&encodeprob.es);
-   rc_writelp = writeLP(gmo, gev, appendbufferConvert, &encodeprob);
-   if( rc_writelp == RETURN_ERROR_WRITEFUNC )
-   {
-      gevLogStat(gev, "submitjob: Error converting problem to Base-64 .lp string representation. Probably out-of-memory.\n");
-      goto TERMINATE;
-   }
-   else if( rc_writelp != RETURN_OK )
-   {
-      gevLogStat(gev, "submitjob: Error converting problem to .lp string representation.\n");
-      goto TERMINATE;
-   }
-   if( ensurebuffer(&encodeprob.buffer, 6) < 6 )  /* 2 for blockend, 4 for terminating "}]} */
+#ifndef _WIN32
+   if( pthread_create(&se->prewarmthread, NULL, prewarmCurl, se) != 0 )
    {
-      gevLogStat(gev, "submitjob: Out-of-memory converting problem.\n");
-      goto TERMINATE;
+      gevLog(se->gev, "Could not start thread to prepare connection to SolveEngine.");
+      return;
    }
-   encodeprob.buffer.length += base64_encode_blockend((char*)encodeprob.buffer.content + encodeprob.buffer.length, &encodeprob.es);
-
-   /* append closing parenthesis and start of timeout attribute */
-   appendbuffer(&encodeprob.buffer, "\"}],\"timeout\": ");
 
-   /* append timelimit (in seconds as integer), must be >= 60 */
-   ensurebuffer(&encodeprob.buffer, 20);
-   encodeprob.buffer.length += sprintf((char*)encodeprob.buffer.content + encodeprob.buffer.length, "%d}", timelimit);
+   se->prewarming = 1;
+#endif
+}
 
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_POSTFIELDS, encodeprob.buffer.content) );
+/** waits for background thread that opens the connection and reports result */
+static
+void finishprewarm(
+   gamsse_t* se
+   )
+{
+   char buffer[GMS_SSSIZE];
 
-   /* get a progress report since this can take time for larger problems */
-   se->progresslastruntime = 0;
-   se->progressisupload = 1;
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_XFERINFOFUNCTION, progressreportCurl) );
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_XFERINFODATA, se) );
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_NOPROGRESS, 0L) );
+   if( !se->prewarming )
+      return;
 
-   /* perform HTTP request */
-   if( performCurl(se, &root) != RETURN_OK )
-      goto TERMINATE;
-   assert(root != NULL);
+#ifndef _WIN32
+   pthread_join(se->prewarmthread, NULL);
+#endif
+   se->prewarming = 0;
 
-   id = cJSON_GetObjectItem(root, "id");
-   if( id == NULL || !cJSON_IsString(id) )
+   if( se->prewarmres != CURLE_OK )
    {
-      gevLogStat(gev, "submitjob: Failure obtaining job id from SolveEngine.");
-      goto TERMINATE;
+      sprintf(buffer, "Preparing connection to SolveEngine failed: %s", curl_easy_strerror(se->prewarmres));
+      gevLog(se->gev, buffer);
+      return;
    }
 
-   se->jobid = strdup(id->valuestring);
-   rc = RETURN_OK;
+   if( se->prewarmrespcode >= 400 )
+   {
+      sprintf(buffer, "Preparing connection to SolveEngine: HTTP response code %ld.", se->prewarmrespcode);
+      gevLog(se->gev, buffer);
+   }
 
-TERMINATE :
-   if( root != NULL )
-      cJSON_Delete(root);
+   sprintf(buffer, "Prepared connection to SolveEngine while converting problem: %.3fs connection setup, %.3fs total.", se->prewarmsetup, se->prewarmtotal);
+   gevLog(se->gev, buffer);
+}
 
-   if( postfields != NULL )
-      postfields = NULL;
+/** request for a page of the job list */
+typedef struct
+{
+   CURL*       curl;
+   char        curlerrbuf[CURL_ERROR_SIZE];   /**< buffer for curl to store error message */
+   buffer_t    curlwritebuf;
+   int         page;          /**< number of requested page, 0 if no request */
+   int         busy;          /**< whether request is in flight */
+   int         retries;       /**< number of retries of request for page */
+   CURLcode    result;        /**< result of transfer, if finished */
+} joblistpage_t;
 
-   exitbuffer(&encodeprob.buffer);
+static
+DECL_transferDoneFunc(joblistpagedone)
+{
+   joblistpage_t* page = (joblistpage_t*)userdata;
 
-   return rc;
+   page->busy = 0;
+   page->result = result;
 }
 
-/* schedule a job to be run */
+/* sets up the request for a page of the job list and adds it to the transfer engine */
 static
-RETURN schedulejob(
-   gamsse_t* se
-   )
+RETURN startjoblistpage(
+   gamsse_t*      se,
+   transfer_t*    tr,
+   joblistpage_t* page,
+   int            pagenum,
+   int            pagesize
+)
 {
-   gevHandle_t gev = se->gev;
    char strbuffer[1024];
-   int rc = RETURN_ERROR;
-
-   gevLogPChar(gev, "Scheduling Job. ID: "); gevLog(gev, se->jobid);
+   RETURN rc = RETURN_ERROR;
 
-   if( resetCurl(se) != RETURN_OK )
+   if( setupCurl(se, page->curl, page->curlerrbuf, &page->curlwritebuf) != RETURN_OK )
       goto TERMINATE;
 
-   assert(se->jobid != NULL);
-   sprintf(strbuffer, "https://solve.satalia.com/api/v2/jobs/%s/schedule", se->jobid);
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, strbuffer) );
-
-   /* we want an empty POST request */
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_POSTFIELDS, "") );
+   snprintf(strbuffer, sizeof(strbuffer), "%s/jobs?page=%d&per_page=%d", se->apiurl, pagenum, pagesize);
+   CURL_CHECK( se, curl_easy_setopt(page->curl, CURLOPT_URL, strbuffer) );
 
-   /* perform HTTP request */
-   if( performCurl(se, NULL) != RETURN_OK )
+   if( transferAdd(tr, page->curl, joblistpagedone, page) != RETURN_OK )
       goto TERMINATE;
 
-   if( se->curlwritebuf.length > 2 )
-   {
-      /* something else went wrong */
-      gevLogStatPChar(gev, "schedulejob: Failed to schedule job: ");
-      gevLogStatPChar(gev, (char*)se->curlwritebuf.content);
-      gevLogStatPChar(gev, "\n");
-   }
+   page->page = pagenum;
+   page->busy = 1;
 
    rc = RETURN_OK;
 TERMINATE:
    return rc;
 }
 
-/* job status */
+/* checks whether value appears in a comma-separated list, ignoring case */
 static
-char* jobstatus(
-   gamsse_t* se
-   )
+int inlist(
+   const char* list,
+   const char* value
+)
 {
-   gevHandle_t gev = se->gev;
-   char strbuffer[1024];
+   size_t len;
+
+   len = strlen(value);
+   while( *list != '\0' )
+   {
+      const char* end;
+
+      while( *list == ' ' || *list == ',' )
+         ++list;
+
+      end = list;
+      while( *end != '\0' && *end != ',' && *end != ' ' )
+         ++end;
+
+      if( (size_t)(end - list) == len && strncasecmp(list, value, len) == 0 )
+         return 1;
+
+      list = end;
+   }
+
+   return 0;
+}
+
+/** prints the list of jobs
+ *
+ * The list is retrieved page by page, where the next page is fetched while the current page is printed.
+ * Jobs can be filtered by status (option jobliststatus) and age (option joblistmaxage).
+ * As SolveEngine lists the most recent jobs first, no further pages are retrieved after the first job that is too old.
+ */
+static
+void printjoblist(
+   gamsse_t* se
+)
+{
+   gevHandle_t gev = se->gev;
+   char strbuffer[1024];
+   char statusfilter[GMS_SSSIZE];
+   char cutoff[32];        /* jobs submitted before this time are not printed */
+   transfer_t* tr = NULL;
+   joblistpage_t pages[2];
+   joblistpage_t* page;
    cJSON* root = NULL;
-   cJSON* status = NULL;
-   char* statusstr = NULL;
+   cJSON* jobs = NULL;
+   cJSON* job;
+   double maxage;
+   int pagesize;
+   int hastotal = 0;       /* whether first page gave the total number of jobs */
+   int npages = 1;
+   int nprinted = 0;
+   int stop = 0;
+   int cur = 0;
+   int i;
 
-   if( resetCurl(se) != RETURN_OK )
-      goto TERMINATE;
+   memset(pages, 0, sizeof(pages));
 
-   assert(se->jobid != NULL);
-   sprintf(strbuffer, "https://solve.satalia.com/api/v2/jobs/%s/status", se->jobid);
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, strbuffer) );
+   pagesize = optGetIntStr(se->opt, "joblistpagesize");
+   optGetStrStr(se->opt, "jobliststatus", statusfilter);
+   maxage = optGetDblStr(se->opt, "joblistmaxage");
 
-   /* perform HTTP request */
-   if( performCurl(se, &root) != RETURN_OK )
+   /* SolveEngine gives times in UTC in form 2017-06-20T10:25:10Z, so we can compare strings */
+   *cutoff = '\0';
+   if( maxage < 1e6 )
+   {
+      time_t cutofftime;
+
+      cutofftime = time(NULL) - (time_t)(maxage * 24 * 3600);
+      strftime(cutoff, sizeof(cutoff), "%Y-%m-%dT%H:%M:%SZ", gmtime(&cutofftime));
+   }
+
+   if( transferCreate(&tr, 0) != RETURN_OK )
+   {
+      gevLogStat(gev, "Error in curl_multi_init()\n");
       goto TERMINATE;
+   }
 
-   status = cJSON_GetObjectItem(root, "status");
-   if( status == NULL || !cJSON_IsString(status) )
+   for( i = 0; i < 2; ++i )
    {
-      gevLogStat(gev, "jobstatus: No 'status' in answer from SolveEngine.");
+      pages[i].curl = curl_easy_init();
+      if( pages[i].curl == NULL )
+      {
+         gevLogStat(gev, "Error in curl_easy_init()\n");
+         goto TERMINATE;
+      }
+   }
+
+   if( startjoblistpage(se, tr, &pages[0], 1, pagesize) != RETURN_OK )
       goto TERMINATE;
+
+   do
+   {
+      page = &pages[cur];
+
+      /* wait for current page */
+      while( page->busy )
+         if( transferPerform(tr, 1000) != RETURN_OK )
+            goto TERMINATE;
+
+      if( se->metrics != NULL )
+         metricsAddRequest(se->metrics, page->curl, "joblist", NULL, page->retries, page->result, page->curlwritebuf.length);
+
+      if( page->retries < se->maxretries && istransient(page->curl, page->result) )
+      {
+         ++page->retries;
+         logretry(se, page->curl, page->result, "joblist", page->retries, retrybackoff(se, page->retries));
+         sleepsec(retrybackoff(se, page->retries));
+         if( startjoblistpage(se, tr, page, page->page, pagesize) != RETURN_OK )
+            goto TERMINATE;
+         continue;
+      }
+      page->retries = 0;
+
+      if( evalCurl(se, page->curl, page->result, page->curlerrbuf, &page->curlwritebuf, &root) != RETURN_OK )
+         goto TERMINATE;
+      assert(root != NULL);
+
+      if( page->page == 1 )
+      {
+         cJSON* total = cJSON_GetObjectItem(root, "total");
+
+         /* root is freed after each page, so remember only whether there is a total */
+         if( total == NULL || !cJSON_IsNumber(total) )
+            gevLogPChar(gev, "Printing Joblist:\n");
+         else
+         {
+            hastotal = 1;
+
+            sprintf(strbuffer, "Printing Joblist: %d jobs in total\n", total->valueint);
+            gevLogPChar(gev, strbuffer);
+
+            if( total->valueint == 0 )
+               goto TERMINATE;
+
+            npages = (total->valueint + pagesize - 1) / pagesize;
+         }
+
+         sprintf(strbuffer, "%40s %5s %10s %30s %30s %30s Used\n",
+            "Job ID", "Algo", "Status", "Submittime", "Starttime", "Finishtime");
+         gevLogPChar(gev, strbuffer);
+      }
+
+      jobs = cJSON_GetObjectItem(root, "jobs");
+      if( jobs == NULL || !cJSON_IsArray(jobs) )
+      {
+         gevLogStat(gev, "printjoblist: No 'jobs' found in answer from SolveEngine.");
+         goto TERMINATE;
+      }
+
+      /* without total, we continue as long as we get full pages */
+      if( !hastotal && cJSON_GetArraySize(jobs) == pagesize )
+         npages = page->page + 1;
+
+      /* fetch next page while we print this one */
+      if( page->page < npages )
+         if( startjoblistpage(se, tr, &pages[1-cur], page->page + 1, pagesize) != RETURN_OK )
+            goto TERMINATE;
+
+      cJSON_ArrayForEach(job, jobs)
+      {
+         cJSON* id;
+         cJSON* status;
+         cJSON* algo;
+         cJSON* submitted;
+         cJSON* started;
+         cJSON* finished;
+         cJSON* usedtime;
+         char submittedbuf[32];
+         char startedbuf[32];
+         char finishedbuf[32];
+
+         id = cJSON_GetObjectItem(job, "id");
+         if( id == NULL )
+            continue;
+
+         status = cJSON_GetObjectItem(job, "status");
+         algo = cJSON_GetObjectItem(job, "algorithm");
+         submitted = cJSON_GetObjectItem(job, "submitted");
+         started = cJSON_GetObjectItem(job, "started");
+         finished = cJSON_GetObjectItem(job, "finished");
+         usedtime = cJSON_GetObjectItem(job, "used_time");
+
+         if( *cutoff != '\0' && submitted != NULL && cJSON_IsString(submitted) && strcmp(submitted->valuestring, cutoff) < 0 )
+         {
+            /* this and all further jobs are too old */
+            stop = 1;
+            break;
+         }
+
+         if( *statusfilter != '\0' && (status == NULL || !cJSON_IsString(status) || !inlist(statusfilter, status->valuestring)) )
+            continue;
+
+         sprintf(strbuffer, "%s %5s %10s %30s %30s %30s %4d\n",
+            id->valuestring,
+            algo != NULL ? algo->valuestring : "N/A",
+            status != NULL ? status->valuestring : "N/A",
+            formattime(submittedbuf, submitted != NULL ? submitted->valuestring : NULL),
+            formattime(startedbuf, started != NULL ? started->valuestring : NULL),
+            formattime(finishedbuf, finished != NULL ? finished->valuestring : NULL),
+            usedtime ? usedtime->valueint : 0
+         );
+         gevLogPChar(gev, strbuffer);
+
+         /* keep the prefetch going */
+         if( ++nprinted % 64 == 0 && transferPerform(tr, 0) != RETURN_OK )
+            goto TERMINATE;
+      }
+
+      cJSON_Delete(root);
+      root = NULL;
+
+      cur = 1 - cur;
    }
+   while( !stop && pages[cur].busy );
 
-   statusstr = strdup(status->valuestring);
+   if( *statusfilter != '\0' || *cutoff != '\0' )
+   {
+      sprintf(strbuffer, "%d jobs matched filter\n", nprinted);
+      gevLogPChar(gev, strbuffer);
+   }
 
 TERMINATE :
+   /* aborts prefetched page, if not needed */
+   transferFree(&tr);
+
+   for( i = 0; i < 2; ++i )
+   {
+      if( pages[i].curl != NULL )
+         curl_easy_cleanup(pages[i].curl);
+      exitbuffer(&pages[i].curlwritebuf);
+   }
+
    if( root != NULL )
       cJSON_Delete(root);
+}
+
+/* converts problem into body of submit request
+ *
+ * If a base is given, then the body holds only the changes of the vectors of the model against the base,
+ * which SolveEngine already has, instead of the problem in .lp format.
+ * If a block is given, then the body holds only the variables and rows of this block of the decomposition.
+ * If a problem key is given, then SolveEngine keeps the problem under this key, so that later submits can refer to it.
+ */
+static
+RETURN buildproblem(
+   gamsse_t*           se,
+   buffer_t*           problem,
+   const modeldelta_t* base,      /**< model that the changes refer to, or NULL to send complete problem */
+   int                 block,     /**< block to send, or -1 to send complete instance */
+   const char*         problemkey /**< key under which SolveEngine keeps the problem, or NULL */
+   )
+{
+   gevHandle_t gev = se->gev;
+   gmoHandle_t gmo = se->gmo;
+   encodeprob_t encodeprob = { .buffer = BUFFERINIT };
+   RETURN rc = RETURN_ERROR;
+   RETURN rc_writelp;
+   int timelimit;
+   char strbuffer[GMS_SSSIZE];
+
+   assert(problem != NULL);
+
+   /* SolveEngine time limit must be integer and >= 60 */
+   timelimit = (int)gevGetDblOpt(se->gev, gevResLim);
+   if( timelimit < 60 )
+   {
+      gevLog(gev, "SolveEngine requires a time limit (reslim) of at least 60 seconds.");
+      timelimit = 60;
+   }
+
+   /* the jobs of all blocks get the same time limit and options, so log them once */
+   if( block <= 0 )
+   {
+      sprintf(strbuffer, "Submitting Job with %d seconds time limit.", timelimit);
+      gevLog(gev, strbuffer);
+   }
+
+   if( block <= 0 && se->solveroptions != NULL && strcmp(se->solveroptions, "{}") != 0 )
+   {
+      gevLogPChar(gev, "Solver options: ");
+      gevLog(gev, se->solveroptions);
+   }
+
+   /* post fields */
+   appendbuffer(&encodeprob.buffer, "{\"options\":");
+   appendbuffer(&encodeprob.buffer, se->solveroptions != NULL ? se->solveroptions : "{}");
+
+   if( base != NULL )
+   {
+      /* changes against base, see modeldeltaWriteJSON() */
+      assert(se->modeldelta != NULL);
+      sprintf(strbuffer, ",\"base\":\"%s\",\"delta\":", base->problemkey);
+      appendbuffer(&encodeprob.buffer, strbuffer);
+      if( modeldeltaWriteJSON(base, se->modeldelta, gmoPinf(gmo), appendbufferWrite, &encodeprob.buffer) != RETURN_OK )
+      {
+         gevLogStat(gev, "submitjob: Out-of-memory converting changes of problem.\n");
+         goto TERMINATE;
+      }
+      appendbuffer(&encodeprob.buffer, ",\"problems\":[");
+   }
+   else
+   {
+      appendbuffer(&encodeprob.buffer, ",\"problems\":[{\"name\":\"problem.lp\",\"data\": \"");
+      assert(encodeprob.buffer.length > 0);
+
+      /* append base64 encode of string in LP format (this will not be 0-terminated) */
+      base64_init_encodestate(&encodeprob.es);
+      rc_writelp = writeLP(gmo, gev, se->presolve, se->decomp, block, appendbufferConvert, &encodeprob);
+      if( rc_writelp == RETURN_ERROR_WRITEFUNC )
+      {
+         gevLogStat(gev, "submitjob: Error converting problem to Base-64 .lp string representation. Probably out-of-memory.\n");
+         goto TERMINATE;
+      }
+      else if( rc_writelp != RETURN_OK )
+      {
+         gevLogStat(gev, "submitjob: Error converting problem to .lp string representation.\n");
+         goto TERMINATE;
+      }
+      if( ensurebuffer(&encodeprob.buffer, 6) < 6 )  /* 2 for blockend, 4 for terminating "}]} */
+      {
+         gevLogStat(gev, "submitjob: Out-of-memory converting problem.\n");
+         goto TERMINATE;
+      }
+      encodeprob.buffer.length += base64_encode_blockend((char*)encodeprob.buffer.content + encodeprob.buffer.length, &encodeprob.es);
+      appendbuffer(&encodeprob.buffer, "\"}");
+   }
+
+   /* append current levels as start solution, so that the solver can start with an incumbent */
+   if( optGetIntStr(se->opt, "mipstart") && gmoNDisc(gmo) > 0 )
+   {
+      if( block <= 0 )
+      {
+         sprintf(strbuffer, "Sending levels of %d variables as MIP start.", gmoN(gmo));
+         gevLog(gev, strbuffer);
+      }
+
+      appendbuffer(&encodeprob.buffer, base != NULL ? "{\"name\":\"problem.mst\",\"data\": \"" : ",{\"name\":\"problem.mst\",\"data\": \"");
+      base64_init_encodestate(&encodeprob.es);
+      if( writeMST(gmo, gev, se->presolve, se->decomp, block, appendbufferConvert, &encodeprob) != RETURN_OK )
+      {
+         gevLogStat(gev, "submitjob: Error converting MIP start to Base-64 .mst string representation. Probably out-of-memory.\n");
+         goto TERMINATE;
+      }
+      if( ensurebuffer(&encodeprob.buffer, 2) < 2 )
+      {
+         gevLogStat(gev, "submitjob: Out-of-memory converting MIP start.\n");
+         goto TERMINATE;
+      }
+      encodeprob.buffer.length += base64_encode_blockend((char*)encodeprob.buffer.content + encodeprob.buffer.length, &encodeprob.es);
+      appendbuffer(&encodeprob.buffer, "\"}");
+   }
+
+   /* the time limit does not change the results of a job that finished, so leave it out of the key for the result cache */
+   if( se->cache != NULL )
+      resultcacheKey(encodeprob.buffer.content, encodeprob.buffer.length, se->cachekey);
+
+   appendbuffer(&encodeprob.buffer, "]");
+
+   /* let SolveEngine keep the problem, so that later submits can refer to it */
+   if( problemkey != NULL )
+   {
+      sprintf(strbuffer, ",\"problem_key\":\"%s\"", problemkey);
+      appendbuffer(&encodeprob.buffer, strbuffer);
+   }
+
+   /* append start of timeout attribute */
+   appendbuffer(&encodeprob.buffer, ",\"timeout\": ");
+
+   /* append timelimit (in seconds as integer), must be >= 60 */
+   ensurebuffer(&encodeprob.buffer, 20);
+   encodeprob.buffer.length += sprintf((char*)encodeprob.buffer.content + encodeprob.buffer.length, "%d}", timelimit);
+
+   /* hand over buffer to caller */
+   *problem = encodeprob.buffer;
+   encodeprob.buffer.content = NULL;
+
+   rc = RETURN_OK;
+
+TERMINATE :
+   exitbuffer(&encodeprob.buffer);
+
+   return rc;
+}
+
+/** generates a random UUID (version 4) to be used as idempotency key */
+static
+void makeidempotencykey(
+   char* key             /**< buffer to store key, must have length at least 37 */
+   )
+{
+   unsigned char bytes[16];
+   size_t nread = 0;
+   FILE* urandom;
+   int i;
+
+   urandom = fopen("/dev/urandom", "rb");
+   if( urandom != NULL )
+   {
+      nread = fread(bytes, 1, sizeof(bytes), urandom);
+      fclose(urandom);
+   }
+   if( nread < sizeof(bytes) )
+   {
+      /* no /dev/urandom (Windows): fall back to rand(), seeded with time and address of key */
+      srand((unsigned int)time(NULL) ^ (unsigned int)(size_t)key);
+      for( i = 0; i < (int)sizeof(bytes); ++i )
+         bytes[i] = (unsigned char)(rand() >> 3);
+   }
+
+   bytes[6] = (bytes[6] & 0x0f) | 0x40;  /* version 4 */
+   bytes[8] = (bytes[8] & 0x3f) | 0x80;  /* variant 1 */
+
+   for( i = 0; i < 16; ++i )
+   {
+      sprintf(key, "%02x", bytes[i]);
+      key += 2;
+      if( i == 3 || i == 5 || i == 7 || i == 9 )
+         *key++ = '-';
+   }
+   *key = '\0';
+}
+
+static
+void freeupload(
+   upload_t** upload
+   )
+{
+   int i;
+
+   assert(upload != NULL);
+
+   if( *upload == NULL )
+      return;
+
+   for( i = 0; i < (*upload)->nslots; ++i )
+   {
+      uploadslot_t* slot = &(*upload)->slots[i];
+
+      if( slot->curl != NULL )
+         curl_easy_cleanup(slot->curl);
+      if( slot->headers != NULL )
+         curl_slist_free_all(slot->headers);
+      exitbuffer(&slot->curlwritebuf);
+   }
+
+   free((*upload)->slots);
+   free((*upload)->chunkstate);
+   free((*upload)->chunkretries);
+   free((*upload)->sessionid);
+   free(*upload);
+   *upload = NULL;
+}
+
+/** prepares the upload of the problem of a job in chunks */
+static
+RETURN initupload(
+   sejob_t*    job
+   )
+{
+   gamsse_t* se = job->se;
+   upload_t* upload;
+   int i;
+
+   assert(job->upload == NULL);
+   assert(se->uploadchunksize > 0);
+
+   upload = (upload_t*) calloc(1, sizeof(upload_t));
+   if( upload == NULL )
+      goto OUTOFMEMORY;
+   job->upload = upload;
+
+   upload->chunksize = se->uploadchunksize;
+   upload->nchunks = (int)((job->problem->length + upload->chunksize - 1) / upload->chunksize);
+   upload->chunkstate = (char*) calloc(upload->nchunks, sizeof(char));
+   upload->chunkretries = (int*) calloc(upload->nchunks, sizeof(int));
+   if( upload->chunkstate == NULL || upload->chunkretries == NULL )
+      goto OUTOFMEMORY;
+
+   upload->nslots = se->uploadconnections < upload->nchunks ? se->uploadconnections : upload->nchunks;
+   upload->slots = (uploadslot_t*) calloc(upload->nslots, sizeof(uploadslot_t));
+   if( upload->slots == NULL )
+      goto OUTOFMEMORY;
+
+   for( i = 0; i < upload->nslots; ++i )
+   {
+      upload->slots[i].job = job;
+      upload->slots[i].chunk = -1;
+      upload->slots[i].curl = curl_easy_init();
+      if( upload->slots[i].curl == NULL )
+      {
+         gevLogStat(se->gev, "Error in curl_easy_init()\n");
+         return RETURN_ERROR;
+      }
+   }
+
+   sprintf(upload->request, "{\"length\":%lu}", (unsigned long)job->problem->length);
+
+   return RETURN_OK;
+
+OUTOFMEMORY:
+   gevLogStat(se->gev, "Out of memory.\n");
+   return RETURN_ERROR;
+}
+
+static const backend_t solveenginebackend;
+
+static
+RETURN initjob(
+   gamsse_t*   se,
+   sejob_t*    job,
+   const char* name,
+   buffer_t*   problem
+   )
+{
+   char buffer[100];
+
+   assert(se != NULL);
+   assert(job != NULL);
+
+   memset(job, 0, sizeof(sejob_t));
+   job->se = se;
+   job->name = name;
+   job->backend = &solveenginebackend;
+   job->problem = problem;
+   job->block = -1;
+   job->phase = JOBPHASE_SUBMIT;
+
+   job->curl = curl_easy_init();
+   if( job->curl == NULL )
+   {
+      gevLogStat(se->gev, "Error in curl_easy_init()\n");
+      return RETURN_ERROR;
+   }
+
+   /* a submit request that is repeated after a failure must not create a second job,
+    * so give SolveEngine a key that identifies all attempts of this submission
+    */
+   makeidempotencykey(job->idempotencykey);
+   sprintf(buffer, "Idempotency-Key: %s", job->idempotencykey);
+   job->submitheaders = curl_slist_append(NULL, buffer);
+   if( job->submitheaders != NULL && se->apikey != NULL )
+   {
+      snprintf(buffer, sizeof(buffer), "Authorization: api-key %s", se->apikey);
+      if( curl_slist_append(job->submitheaders, buffer) == NULL )
+      {
+         curl_slist_free_all(job->submitheaders);
+         job->submitheaders = NULL;
+      }
+   }
+   if( job->submitheaders == NULL )
+   {
+      gevLogStat(se->gev, "Error in curl_slist_append()\n");
+      return RETURN_ERROR;
+   }
+
+   if( se->streamresults && solreaderCreate(&job->solreader, gmoN(se->gmo)) != RETURN_OK )
+   {
+      gevLogStat(se->gev, "Out of memory.\n");
+      return RETURN_ERROR;
+   }
+
+   if( se->uploadchunksize > 0 && problem != NULL && problem->length > se->uploadchunksize )
+      return initupload(job);
+
+   return RETURN_OK;
+}
+
+static
+void freejob(
+   sejob_t* job
+   )
+{
+   assert(job != NULL);
+
+   if( job->results != NULL )
+      cJSON_Delete(job->results);
+
+   solreaderFree(&job->solreader);
+
+   localsolveFree(&job->local);
+
+   if( job->curl != NULL )
+      curl_easy_cleanup(job->curl);
+
+   if( job->submitheaders != NULL )
+      curl_slist_free_all(job->submitheaders);
+
+   freeupload(&job->upload);
+
+   exitbuffer(&job->curlwritebuf);
+
+   free(job->jobid);
+
+   memset(job, 0, sizeof(sejob_t));
+}
+
+/* logs a message about a job, prefixed with the job name if there are several jobs */
+static
+void logjob(
+   sejob_t*    job,
+   const char* msg
+   )
+{
+   if( job->name != NULL )
+   {
+      gevLogPChar(job->se->gev, job->name);
+      gevLogPChar(job->se->gev, ": ");
+   }
+   gevLog(job->se->gev, msg);
+}
+
+/* whether a job with this status is still waiting for being solved or being solved */
+static
+int jobstatusisrunning(
+   JOBSTATUS status
+   )
+{
+   switch( status )
+   {
+      case JOBSTATUS_CREATED :      /* we should not get status "created" after having submitted the job, but it seems to happen anyway; hopefully we just have to wait a bit */
+      case JOBSTATUS_QUEUED :       /* if queued, then we wait for available resources - hope that this wouldn't take too long */
+      case JOBSTATUS_TRANSLATING :
+      case JOBSTATUS_STARTING :
+      case JOBSTATUS_STARTED :
+         return 1;
+      default :
+         return 0;
+   }
+}
+
+/** skips whitespace in a JSON text */
+static
+const char* skipjsonspace(
+   const char* p,
+   const char* end
+   )
+{
+   while( p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') )
+      ++p;
+   return p;
+}
+
+/** skips a JSON string that starts at p, gives position after closing quote, or NULL if string does not end */
+static
+const char* skipjsonstring(
+   const char* p,
+   const char* end
+   )
+{
+   assert(*p == '"');
+
+   for( ++p; p < end; ++p )
+      if( *p == '\\' )
+         ++p;
+      else if( *p == '"' )
+         return p+1;
+
+   return NULL;
+}
+
+/** skips a JSON value, gives position of the comma or bracket that follows it, or NULL if there is none */
+static
+const char* skipjsonvalue(
+   const char* p,
+   const char* end
+   )
+{
+   int depth = 0;
+
+   while( p < end )
+   {
+      if( *p == '"' )
+      {
+         p = skipjsonstring(p, end);
+         if( p == NULL )
+            return NULL;
+         continue;
+      }
+
+      if( depth == 0 && (*p == ',' || *p == '}' || *p == ']') )
+         return p;
+
+      if( *p == '{' || *p == '[' )
+         ++depth;
+      else if( *p == '}' || *p == ']' )
+         --depth;
+      ++p;
+   }
+
+   return NULL;
+}
+
+/** finds a top-level member of a JSON object in place, gives the beginning of its value, or NULL if not found
+ *
+ * Key names are compared case-insensitive, as cJSON_GetObjectItem() does.
+ */
+static
+const char* findjsonmember(
+   const char*  json,
+   size_t       length,
+   const char*  name
+   )
+{
+   const char* end = json + length;
+   const char* p;
+   size_t namelength;
+
+   namelength = strlen(name);
+
+   p = skipjsonspace(json, end);
+   if( p == end || *p != '{' )
+      return NULL;
+   ++p;
+
+   for( ;; )
+   {
+      const char* key;
+      size_t keylength;
+
+      p = skipjsonspace(p, end);
+      if( p == end || *p != '"' )
+         return NULL;
+      key = p+1;
+      p = skipjsonstring(p, end);
+      if( p == NULL )
+         return NULL;
+      keylength = (size_t)(p - 1 - key);
+
+      p = skipjsonspace(p, end);
+      if( p == end || *p != ':' )
+         return NULL;
+      p = skipjsonspace(p+1, end);
+
+      if( keylength == namelength && strncasecmp(key, name, namelength) == 0 )
+         return p < end ? p : NULL;
+
+      p = skipjsonvalue(p, end);
+      if( p == NULL || *p != ',' )
+         return NULL;
+      ++p;
+   }
+}
+
+/** gets the status from the response of a status request
+ *
+ * The response is small and polled often, so it is scanned in place for the top-level member "status",
+ * without allocating a tree of the response or a copy of the status.
+ */
+static
+JOBSTATUS parsejobstatus(
+   const char*  json,
+   size_t       length,
+   const char** text,        /**< to store beginning of status in response, or NULL if not in response */
+   size_t*      textlength   /**< to store length of status in response */
+   )
+{
+   const char* end = json + length;
+   const char* p;
+   int s;
+
+   *text = NULL;
+   *textlength = 0;
+
+   p = findjsonmember(json, length, "status");
+   if( p == NULL || *p != '"' )
+      return JOBSTATUS_UNKNOWN;
+
+   *text = p+1;
+   p = skipjsonstring(p, end);
+   if( p == NULL )
+   {
+      *text = NULL;
+      return JOBSTATUS_UNKNOWN;
+   }
+   *textlength = (size_t)(p - 1 - *text);
+
+   for( s = JOBSTATUS_UNKNOWN + 1; s < JOBSTATUS_OTHER; ++s )
+      if( strlen(jobstatusname[s]) == *textlength && strncmp(jobstatusname[s], *text, *textlength) == 0 )
+         return (JOBSTATUS)s;
+
+   return JOBSTATUS_OTHER;
+}
+
+/** gets a number from a top-level member of the response of a status request, gives whether there was one */
+static
+int parsejobnumber(
+   const char*  json,
+   size_t       length,
+   const char*  name,
+   double*      value
+   )
+{
+   const char* end = json + length;
+   const char* p;
+   char number[64];
+   char* numend;
+   size_t n = 0;
+
+   p = findjsonmember(json, length, name);
+   if( p == NULL || !(*p == '-' || (*p >= '0' && *p <= '9')) )
+      return 0;
+
+   /* the response is not 0-terminated, so copy the number before handing it to strtod() */
+   while( p < end && n < sizeof(number)-1 && *p != '\0' && strchr("+-.0123456789eE", *p) != NULL )
+      number[n++] = *p++;
+   number[n] = '\0';
+
+   *value = strtod(number, &numend);
+
+   return *numend == '\0' && isfinite(*value);
+}
+
+static
+DECL_transferDoneFunc(chunkdone);
+
+/** starts the upload of a chunk that has not been uploaded yet via a given connection
+ *
+ * Does nothing if all remaining chunks are already in flight.
+ */
+static
+RETURN startchunk(
+   transfer_t*   tr,
+   uploadslot_t* slot
+   )
+{
+   sejob_t* job = slot->job;
+   gamsse_t* se = job->se;
+   upload_t* upload = job->upload;
+   char strbuffer[1024];
+   curl_off_t offset;
+   curl_off_t length;
+   RETURN rc = RETURN_ERROR;
+   int chunk;
+   int i;
+
+   assert(slot->chunk == -1);
+
+   /* continue with the chunk after the one that has been started last, so failed chunks are repeated at the end */
+   chunk = -1;
+   for( i = 0; i < upload->nchunks; ++i )
+   {
+      int c = (upload->nextchunk + i) % upload->nchunks;
+      if( upload->chunkstate[c] == 0 )
+      {
+         chunk = c;
+         break;
+      }
+   }
+   if( chunk < 0 )
+      return RETURN_OK;
+   upload->nextchunk = chunk + 1;
+
+   offset = (curl_off_t)chunk * upload->chunksize;
+   length = (curl_off_t)job->problem->length - offset;
+   if( length > (curl_off_t)upload->chunksize )
+      length = upload->chunksize;
+
+   if( setupCurl(se, slot->curl, slot->curlerrbuf, &slot->curlwritebuf) != RETURN_OK )
+      goto TERMINATE;
+
+   snprintf(strbuffer, sizeof(strbuffer), "%s/uploads/%s", se->apiurl, upload->sessionid);
+   CURL_CHECK( se, curl_easy_setopt(slot->curl, CURLOPT_URL, strbuffer) );
+   CURL_CHECK( se, curl_easy_setopt(slot->curl, CURLOPT_CUSTOMREQUEST, "PUT") );
+   CURL_CHECK( se, curl_easy_setopt(slot->curl, CURLOPT_POSTFIELDS, (char*)job->problem->content + offset) );
+   CURL_CHECK( se, curl_easy_setopt(slot->curl, CURLOPT_POSTFIELDSIZE_LARGE, length) );
+
+   /* HTTP/2 would multiplex all chunks over one connection, but we want to use several */
+   CURL_CHECK( se, curl_easy_setopt(slot->curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_1_1) );
+
+   if( slot->headers != NULL )
+      curl_slist_free_all(slot->headers);
+   sprintf(strbuffer, "Content-Range: bytes %" CURL_FORMAT_CURL_OFF_T "-%" CURL_FORMAT_CURL_OFF_T "/%lu",
+      offset, offset + length - 1, (unsigned long)job->problem->length);
+   slot->headers = curl_slist_append(NULL, strbuffer);
+   if( slot->headers == NULL || curl_slist_append(slot->headers, "Content-Type: application/octet-stream") == NULL )
+      goto TERMINATE;
+   snprintf(strbuffer, sizeof(strbuffer), "Authorization: api-key %s", se->apikey);
+   if( curl_slist_append(slot->headers, strbuffer) == NULL )
+      goto TERMINATE;
+   CURL_CHECK( se, curl_easy_setopt(slot->curl, CURLOPT_HTTPHEADER, slot->headers) );
+
+   if( transferAdd(tr, slot->curl, chunkdone, slot) != RETURN_OK )
+   {
+      gevLogStat(se->gev, "Error adding request to curl multi handle.");
+      goto TERMINATE;
+   }
+   upload->chunkstate[chunk] = 1;
+   slot->chunk = chunk;
+   ++job->busy;
+
+   rc = RETURN_OK;
+TERMINATE:
+   return rc;
+}
+
+/** processes the response to the upload of a chunk and starts the upload of a next chunk via the same connection
+ *
+ * When no chunk is in flight anymore, moves the job into the next phase.
+ */
+static
+DECL_transferDoneFunc(chunkdone)
+{
+   uploadslot_t* slot = (uploadslot_t*)userdata;
+   sejob_t* job = slot->job;
+   gamsse_t* se = job->se;
+   upload_t* upload = job->upload;
+   char strbuffer[1024];
+   int chunk;
+   int retry;
+
+   assert(job->busy > 0);
+   assert(slot->chunk >= 0);
+   --job->busy;
+   chunk = slot->chunk;
+   slot->chunk = -1;
+   retry = upload->chunkretries[chunk];
+
+   if( upload->chunkretries[chunk] < se->maxretries && istransient(curl, result) )
+   {
+      /* upload this chunk again later; let the other connections continue meanwhile */
+      upload->chunkstate[chunk] = 0;
+      ++upload->chunkretries[chunk];
+      if( upload->chunkretries[chunk] > job->retries )
+         job->retries = upload->chunkretries[chunk];
+      job->nextrequest = gevTimeDiffStart(se->gev) + retrybackoff(se, job->retries);
+
+      if( job->name != NULL )
+      {
+         gevLogPChar(se->gev, job->name);
+         gevLogPChar(se->gev, ": ");
+      }
+      logretry(se, curl, result, "chunk", upload->chunkretries[chunk], retrybackoff(se, job->retries));
+   }
+   else if( evalCurl(se, curl, result, slot->curlerrbuf, &slot->curlwritebuf, NULL) != RETURN_OK )
+   {
+      upload->chunkstate[chunk] = 0;
+      upload->failed = 1;
+   }
+   else
+   {
+      upload->chunkstate[chunk] = 2;
+      ++upload->nchunksdone;
+
+      /* don't print if less than 1 second passed since last print */
+      if( gevTimeDiffStart(se->gev) - job->progresslastruntime >= 1.0 || upload->nchunksdone == upload->nchunks )
+      {
+         job->progresslastruntime = gevTimeDiffStart(se->gev);
+         sprintf(strbuffer, "%6.1fs: %s%s%d of %d chunks uploaded\n", job->progresslastruntime,
+            job->name != NULL ? job->name : "", job->name != NULL ? ": " : "",
+            upload->nchunksdone, upload->nchunks);
+         gevLogPChar(se->gev, strbuffer);
+      }
+
+      /* keep this connection busy */
+      if( !upload->failed && startchunk(upload->tr, slot) != RETURN_OK )
+         upload->failed = 1;
+   }
+
+   if( se->metrics != NULL )
+      metricsAddRequest(se->metrics, curl, "chunk", NULL, retry, result, slot->curlwritebuf.length);
+
+   if( job->busy > 0 )
+      return;
+
+   if( upload->failed )
+   {
+      logjob(job, "Upload of problem failed.");
+      job->phase = JOBPHASE_DONE;
+   }
+   else if( upload->nchunksdone == upload->nchunks )
+   {
+      job->retries = 0;
+      job->phase = JOBPHASE_COMMIT;
+   }
+   /* else some chunks need to be repeated, which runjobs() starts when the backoff passed */
+}
+
+/** starts the upload of chunks via all connections of an upload */
+static
+RETURN startupload(
+   transfer_t* tr,
+   sejob_t*    job
+   )
+{
+   upload_t* upload = job->upload;
+   int i;
+
+   assert(upload != NULL);
+   assert(job->busy == 0);
+
+   upload->tr = tr;
+   for( i = 0; i < upload->nslots; ++i )
+      if( startchunk(tr, &upload->slots[i]) != RETURN_OK )
+         return RETURN_ERROR;
+
+   return RETURN_OK;
+}
+
+/** reads objective value of incumbent, bound, and gap from the response to a status request of a running job
+ *
+ * SolveEngine may report these as top-level members objective_value, best_bound, and gap of the status.
+ * Changes are logged, and the stop rules of the link are checked.
+ */
+static
+void updateprogress(
+   sejob_t* job,
+   double   now
+   )
+{
+   gamsse_t* se = job->se;
+   const char* json = (const char*)job->curlwritebuf.content;
+   size_t length = job->curlwritebuf.length;
+   char strbuffer[1024];
+   double incumbent;
+   double bound;
+   double gap;
+   int changed = 0;
+
+   if( !parsejobnumber(json, length, "objective_value", &incumbent) )
+      return;
+   if( !parsejobnumber(json, length, "best_bound", &bound) )
+      bound = NAN;
+   if( !parsejobnumber(json, length, "gap", &gap) )
+   {
+      /* relative gap as GAMS defines it for optcr */
+      if( !isnan(bound) && incumbent != bound )
+         gap = fabs(bound - incumbent) / fmax(fabs(bound), fabs(incumbent));
+      else if( !isnan(bound) )
+         gap = 0.0;
+      else
+         gap = NAN;
+   }
+
+   if( !job->hasincumbent || incumbent != job->incumbent )
+   {
+      job->hasincumbent = 1;
+      job->incumbent = incumbent;
+      job->lastimprove = now;
+      changed = 1;
+   }
+   if( (isnan(bound) ? !isnan(job->bound) : bound != job->bound) )
+   {
+      job->bound = bound;
+      changed = 1;
+   }
+   job->gap = gap;
+
+   if( changed )
+   {
+      int n;
+
+      n = sprintf(strbuffer, "%8.1fs Job %s%sIncumbent: %.10g", now - job->starttime,
+         job->name != NULL ? job->name : "", job->name != NULL ? " " : "", incumbent);
+      if( !isnan(bound) )
+         n += sprintf(strbuffer + n, "  Bound: %.10g", bound);
+      if( !isnan(gap) )
+         n += sprintf(strbuffer + n, "  Gap: %.4f%%", 100.0 * gap);
+      strcpy(strbuffer + n, "\n");
+      gevLogPChar(se->gev, strbuffer);
+   }
+
+   if( job->stop != JOBSTOP_NONE )
+      return;
+
+   if( se->stopgap > 0.0 && !isnan(gap) && gap <= se->stopgap )
+   {
+      sprintf(strbuffer, "Gap %.4f%% reached stopgap, stopping job.", 100.0 * gap);
+      logjob(job, strbuffer);
+      job->stop = JOBSTOP_GAP;
+   }
+   else if( se->stopnoimprove > 0.0 && now - job->lastimprove >= se->stopnoimprove )
+   {
+      sprintf(strbuffer, "Incumbent did not change for %.1fs, stopping job.", now - job->lastimprove);
+      logjob(job, strbuffer);
+      job->stop = JOBSTOP_NOIMPROVE;
+   }
+}
+
+/* processes the response to the request for the current phase of a job and moves the job into its next phase */
+static
+DECL_transferDoneFunc(jobrequestdone)
+{
+   sejob_t* job = (sejob_t*)userdata;
+   gamsse_t* se = job->se;
+   char strbuffer[1024];
+   cJSON* root = NULL;
+   cJSON* item;
+   JOBPHASE phase;
+   curl_off_t decoded;
+   int streamed;
+   int indexed;
+
+   assert(job->busy);
+   assert(job->curl == curl);
+   job->busy = 0;
+
+   phase = job->phase;
+
+   /* size of response after decompression, streamed results do not go into the write buffer */
+   decoded = (phase == JOBPHASE_RESULTS && se->streamresults) ? (curl_off_t)solreaderGetLength(job->solreader) : (curl_off_t)job->curlwritebuf.length;
+
+   /* scheduling a job twice is not harmless, but all other requests can be repeated:
+    * status and results only read, and repeated submissions carry the same idempotency key
+    */
+   if( phase != JOBPHASE_SCHEDULE && job->retries < se->maxretries && istransient(curl, result) )
+   {
+      ++job->retries;
+      job->nextrequest = gevTimeDiffStart(se->gev) + retrybackoff(se, job->retries);
+      if( job->name != NULL )
+      {
+         gevLogPChar(se->gev, job->name);
+         gevLogPChar(se->gev, ": ");
+      }
+      logretry(se, curl, result, jobphasename[phase], job->retries, retrybackoff(se, job->retries));
+
+      if( se->metrics != NULL )
+         metricsAddRequest(se->metrics, curl, jobphasename[phase], job->jobid, job->retries-1, result, decoded);
+      return;
+   }
+
+   /* results have been parsed while downloading, or are large and are read via a structural index instead of a cJSON tree */
+   streamed = (phase == JOBPHASE_RESULTS && se->streamresults);
+   indexed = (phase == JOBPHASE_RESULTS && !se->streamresults && se->indexthreshold > 0 && job->curlwritebuf.length > se->indexthreshold);
+
+   /* let evalCurl() see the beginning of streamed results for error messages */
+   if( streamed )
+      appendbuffer(&job->curlwritebuf, (char*)solreaderGetHead(job->solreader, NULL));
+
+   if( evalCurl(se, curl, result, job->curlerrbuf, &job->curlwritebuf,
+         (phase != JOBPHASE_SCHEDULE && phase != JOBPHASE_POLL && !streamed && !indexed) ? &root : NULL) != RETURN_OK )
+   {
+      /* give up on this job */
+      job->phase = JOBPHASE_DONE;
+      goto TERMINATE;
+   }
+
+   switch( job->phase )
+   {
+      case JOBPHASE_SUBMIT :
+      case JOBPHASE_COMMIT :
+         item = cJSON_GetObjectItem(root, "id");
+         if( item == NULL || !cJSON_IsString(item) )
+         {
+            gevLogStat(se->gev, "submitjob: Failure obtaining job id from SolveEngine.");
+            job->phase = JOBPHASE_DONE;
+            break;
+         }
+
+         if( job->phase == JOBPHASE_SUBMIT && job->upload != NULL )
+         {
+            /* the id is the one of the upload session, the job id comes with the commit */
+            job->upload->sessionid = strdup(item->valuestring);
+            sprintf(strbuffer, "Uploading problem in %d chunks of %lu bytes using %d connections.",
+               job->upload->nchunks, (unsigned long)job->upload->chunksize, job->upload->nslots);
+            logjob(job, strbuffer);
+            job->progresslastruntime = gevTimeDiffStart(se->gev);
+            job->phase = JOBPHASE_UPLOAD;
+            break;
+         }
+
+         job->jobid = strdup(item->valuestring);
+
+         if( se->prewarmsetup > 0.0 )
+         {
+            long nconnects = 1;
+            curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &nconnects);
+            if( nconnects == 0 )
+            {
+               sprintf(strbuffer, "Upload reused prepared connection, hiding %.3fs of connection setup.", se->prewarmsetup);
+               logjob(job, strbuffer);
+            }
+         }
+
+         sprintf(strbuffer, "Scheduling Job. ID: %s", job->jobid);
+         logjob(job, strbuffer);
+         job->phase = JOBPHASE_SCHEDULE;
+         break;
+
+      case JOBPHASE_SCHEDULE :
+         if( job->curlwritebuf.length > 2 )
+         {
+            /* something else went wrong */
+            gevLogStatPChar(se->gev, "schedulejob: Failed to schedule job: ");
+            gevLogStatPChar(se->gev, (char*)job->curlwritebuf.content);
+            gevLogStatPChar(se->gev, "\n");
+         }
+
+         job->starttime = gevTimeDiffStart(se->gev);
+         job->nextrequest = job->starttime + 1.0;
+         job->lastimprove = job->starttime;
+         job->bound = NAN;
+         job->gap = NAN;
+         job->phase = JOBPHASE_POLL;
+         break;
+
+      case JOBPHASE_POLL :
+      {
+         const char* statustext;
+         size_t statuslength;
+
+         job->status = parsejobstatus((char*)job->curlwritebuf.content, job->curlwritebuf.length, &statustext, &statuslength);
+         if( statustext == NULL )
+         {
+            gevLogStat(se->gev, "jobstatus: No 'status' in answer from SolveEngine.");
+            statustext = jobstatusname[JOBSTATUS_UNKNOWN];
+            statuslength = strlen(statustext);
+         }
+
+         sprintf(strbuffer, "%8.1fs Job %s%sStatus: %.*s\n", gevTimeDiffStart(se->gev) - job->starttime,
+            job->name != NULL ? job->name : "", job->name != NULL ? " " : "",
+            statuslength < 100 ? (int)statuslength : 100, statustext);
+         gevLogPChar(se->gev, strbuffer);
+
+         if( job->status == JOBSTATUS_STARTED )
+            updateprogress(job, gevTimeDiffStart(se->gev));
+
+         if( jobstatusisrunning(job->status) )
+            job->nextrequest += 1.0;
+         else if( job->status == JOBSTATUS_COMPLETED || job->stopsent )
+            job->phase = JOBPHASE_RESULTS;  /* a job that we stopped should still give its incumbent */
+         else
+            job->phase = JOBPHASE_DONE;
+         break;
+      }
+
+      case JOBPHASE_RESULTS :
+         if( indexed )
+         {
+            assert(job->solreader == NULL);
+            if( solreaderCreate(&job->solreader, gmoN(se->gmo)) != RETURN_OK )
+               gevLogStat(se->gev, "getsolution: Out of memory.");
+            else
+            {
+               solreaderSetThreads(job->solreader, se->indexthreads);
+               if( solreaderReadIndexed(job->solreader, (char*)job->curlwritebuf.content, job->curlwritebuf.length) == RETURN_OK )
+                  job->resultsread = 1;
+               else
+               {
+                  gevLogStatPChar(se->gev, "getsolution: ");
+                  gevLogStat(se->gev, solreaderGetError(job->solreader));
+               }
+            }
+         }
+         else if( streamed )
+         {
+            if( solreaderFinish(job->solreader) == RETURN_OK )
+               job->resultsread = 1;
+            else
+            {
+               gevLogStatPChar(se->gev, "getsolution: ");
+               gevLogStat(se->gev, solreaderGetError(job->solreader));
+            }
+         }
+         else
+         {
+            job->results = root;
+            root = NULL;
+         }
+         job->phase = JOBPHASE_DONE;
+         break;
+
+      case JOBPHASE_UPLOAD :  /* chunks are handled by chunkdone() */
+      case JOBPHASE_DONE :
+         assert(0);
+         break;
+   }
+
+TERMINATE :
+   /* record statistics after the job id has been obtained from the submit request */
+   if( se->metrics != NULL )
+      metricsAddRequest(se->metrics, curl, jobphasename[phase], job->jobid, job->retries, result, decoded);
+   job->retries = 0;
+
+   if( root != NULL )
+      cJSON_Delete(root);
+}
+
+/* sets up the request for the current phase of a job and adds it to the transfer engine */
+static
+RETURN startjobrequest(
+   transfer_t* tr,
+   sejob_t*    job
+   )
+{
+   gamsse_t* se = job->se;
+   char strbuffer[1024];
+   RETURN rc = RETURN_ERROR;
+
+   assert(!job->busy);
+
+   if( job->phase == JOBPHASE_POLL && job->pollsetup )
+   {
+      /* repeated status poll: the handle is still set up for it, so only forget the previous response */
+      *job->curlerrbuf = '\0';
+      job->curlwritebuf.length = 0;
+   }
+   else
+   {
+      if( setupCurl(se, job->curl, job->curlerrbuf, &job->curlwritebuf) != RETURN_OK )
+         goto TERMINATE;
+      job->pollsetup = 0;
+   }
+
+   switch( job->phase )
+   {
+      case JOBPHASE_SUBMIT :
+         assert(job->problem != NULL);
+         if( job->upload != NULL )
+         {
+            /* open upload session, the problem follows in chunks */
+            snprintf(strbuffer, sizeof(strbuffer), "%s/uploads", se->apiurl);
+            CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_URL, strbuffer) );
+            CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_POSTFIELDS, job->upload->request) );
+            CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_HTTPHEADER, job->submitheaders) );
+            break;
+         }
+
+         snprintf(strbuffer, sizeof(strbuffer), "%s/jobs", se->apiurl);
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_URL, strbuffer) );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_POSTFIELDS, job->problem->content) );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_HTTPHEADER, job->submitheaders) );
+
+         /* get a progress report since this can take time for larger problems */
+         job->progresslastruntime = 0;
+         job->progressisupload = 1;
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_XFERINFOFUNCTION, progressreportCurl) );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_XFERINFODATA, job) );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_NOPROGRESS, 0L) );
+         break;
+
+      case JOBPHASE_UPLOAD :
+         rc = startupload(tr, job);
+         goto TERMINATE;
+
+      case JOBPHASE_COMMIT :
+         assert(job->upload != NULL);
+         assert(job->upload->sessionid != NULL);
+         snprintf(strbuffer, sizeof(strbuffer), "%s/uploads/%s/commit", se->apiurl, job->upload->sessionid);
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_URL, strbuffer) );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_POSTFIELDS, "") );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_HTTPHEADER, job->submitheaders) );
+         break;
+
+      case JOBPHASE_SCHEDULE :
+         assert(job->jobid != NULL);
+         snprintf(strbuffer, sizeof(strbuffer), "%s/jobs/%s/schedule", se->apiurl, job->jobid);
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_URL, strbuffer) );
+
+         /* we want an empty POST request */
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_POSTFIELDS, "") );
+         break;
+
+      case JOBPHASE_POLL :
+         if( job->pollsetup )
+            break;
+         assert(job->jobid != NULL);
+         snprintf(strbuffer, sizeof(strbuffer), "%s/jobs/%s/status", se->apiurl, job->jobid);
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_URL, strbuffer) );
+         job->pollsetup = 1;
+         break;
+
+      case JOBPHASE_RESULTS :
+         logjob(job, "Retrieving results.");
+
+         assert(job->jobid != NULL);
+         snprintf(strbuffer, sizeof(strbuffer), "%s/jobs/%s/results", se->apiurl, job->jobid);
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_URL, strbuffer) );
+
+         /* get a progress report since this can take time for larger problems */
+         job->progresslastruntime = 0;
+         job->progressisupload = 0;
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_XFERINFOFUNCTION, progressreportCurl) );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_XFERINFODATA, job) );
+         CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_NOPROGRESS, 0L) );
+
+         /* parse results while they arrive instead of collecting them in the write buffer */
+         if( job->solreader != NULL )
+         {
+            solreaderReset(job->solreader);
+            CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_WRITEFUNCTION, solreaderWriteCurl) );
+            CURL_CHECK( se, curl_easy_setopt(job->curl, CURLOPT_WRITEDATA, job->solreader) );
+         }
+         break;
+
+      case JOBPHASE_DONE :
+         assert(0);
+         goto TERMINATE;
+   }
+
+   if( transferAdd(tr, job->curl, jobrequestdone, job) != RETURN_OK )
+   {
+      gevLogStat(se->gev, "Error adding request to curl multi handle.");
+      goto TERMINATE;
+   }
+   job->busy = 1;
+
+   rc = RETURN_OK;
+TERMINATE:
+   return rc;
+}
+
+static
+void stopjob(
+   gamsse_t*   se,
+   const char* jobid
+   );
+
+/** stops a job at SolveEngine, if it has been created there */
+static
+void stopsolveengine(
+   sejob_t* job
+   )
+{
+   if( job->jobid != NULL )
+      stopjob(job->se, job->jobid);
+}
+
+/** SolveEngine, where each step of a job is a request that is run by the transfer engine */
+static const backend_t solveenginebackend = { "SolveEngine", startjobrequest, startjobrequest, startjobrequest, stopsolveengine };
+
+/** whether a job has results with status optimal */
+static
+int jobisoptimal(
+   sejob_t* job
+   )
+{
+   const char* status = NULL;
+
+   if( job->results != NULL )
+   {
+      cJSON* item = cJSON_GetObjectItem(cJSON_GetObjectItem(job->results, "result"), "status");
+      if( item != NULL && cJSON_IsString(item) )
+         status = item->valuestring;
+   }
+   else if( job->resultsread )
+      status = solreaderGetStatus(job->solreader);
+
+   return status != NULL && strcmp(status, "optimal") == 0;
+}
+
+/** aborts the requests of a job that are in flight, so that the job is no longer busy */
+static
+void abortrequests(
+   transfer_t* tr,
+   sejob_t*    job
+   )
+{
+   int i;
+
+   if( !job->busy )
+      return;
+
+   /* the handle of the job is not in flight while chunks are uploaded, so this may fail */
+   (void) transferRemove(tr, job->curl);
+
+   if( job->upload != NULL )
+      for( i = 0; i < job->upload->nslots; ++i )
+      {
+         uploadslot_t* slot = &job->upload->slots[i];
+
+         if( slot->chunk < 0 )
+            continue;
+
+         (void) transferRemove(tr, slot->curl);
+         job->upload->chunkstate[slot->chunk] = 0;
+         slot->chunk = -1;
+      }
+
+   job->busy = 0;
+}
+
+/** stops all jobs of a race that are not done yet, because another job finished optimally */
+static
+void endrace(
+   gamsse_t*   se,
+   transfer_t* tr,
+   sejob_t*    jobs,
+   int         njobs,
+   int         winner
+   )
+{
+   char strbuffer[1024];
+   int j;
+
+   for( j = 0; j < njobs; ++j )
+   {
+      if( jobs[j].phase == JOBPHASE_DONE )
+         continue;
+
+      sprintf(strbuffer, "Stopping, as %s finished optimally.", jobs[winner].name);
+      logjob(&jobs[j], strbuffer);
+
+      /* a status poll or download of the job is of no use anymore */
+      abortrequests(tr, &jobs[j]);
+
+      if( !jobs[j].stopsent )
+      {
+         jobs[j].backend->stop(&jobs[j]);
+         jobs[j].stopsent = 1;
+      }
+      jobs[j].phase = JOBPHASE_DONE;
+   }
+}
+
+/** runs jobs concurrently from submission until results are available
+ *
+ * Returns when all jobs are done, the hard time limit has been reached, or on user interrupt.
+ * Jobs that failed are in phase JOBPHASE_DONE without results.
+ * In a race, the first job that finishes optimally ends the run, and the other jobs are stopped and left without results.
+ */
+static
+RETURN runjobs(
+   gamsse_t* se,
+   sejob_t*  jobs,
+   int       njobs,
+   int       race          /**< whether the jobs solve the same problem with different settings */
+   )
+{
+   transfer_t* tr = NULL;
+   RETURN rc = RETURN_ERROR;
+   RETURN rcstep;
+   double now;
+   double wait;
+   int ndone;
+   int j;
+
+   assert(jobs != NULL || njobs == 0);
+
+   if( transferCreate(&tr, 0) != RETURN_OK )
+   {
+      gevLogStat(se->gev, "Error in curl_multi_init()\n");
+      goto TERMINATE;
+   }
+
+   gevTimeSetStart(se->gev);
+
+   for( ;; )
+   {
+      now = gevTimeDiffStart(se->gev);
+      wait = 1.0;
+      ndone = 0;
+
+      for( j = 0; j < njobs; ++j )
+      {
+         sejob_t* job = &jobs[j];
+
+         if( job->phase == JOBPHASE_DONE )
+         {
+            ++ndone;
+            continue;
+         }
+
+         if( job->busy )
+            continue;
+
+         if( job->phase == JOBPHASE_SUBMIT && job->dependson != NULL && job->dependson->jobid == NULL )
+         {
+            if( job->dependson->phase == JOBPHASE_DONE )
+            {
+               logjob(job, "Not submitted, as the job whose problem it refers to could not be created.");
+               job->phase = JOBPHASE_DONE;
+               ++ndone;
+            }
+            continue;
+         }
+
+         if( job->phase == JOBPHASE_POLL && now - job->starttime > se->hardtimelimit )
+         {
+            /* cancel the job, while the caller sets model and solve status, as the limit of one job need not end the solve, e.g., in a race */
+            logjob(job, "Hard time limit reached.\n");
+            if( !job->stopsent )
+            {
+               job->backend->stop(job);
+               job->stopsent = 1;
+            }
+            job->status = JOBSTATUS_TIMEOUT;
+            job->phase = JOBPHASE_DONE;
+            ++ndone;
+            continue;
+         }
+
+         /* a stop rule applied, so stop the job and keep polling until it gives its incumbent */
+         if( job->phase == JOBPHASE_POLL && job->stop != JOBSTOP_NONE && !job->stopsent )
+         {
+            job->backend->stop(job);
+            job->stopsent = 1;
+         }
+
+         /* wait with next poll until one second passed since previous one, or with retry until backoff passed */
+         if( now < job->nextrequest )
+         {
+            if( job->nextrequest - now < wait )
+               wait = job->nextrequest - now;
+            continue;
+         }
+
+         switch( job->phase )
+         {
+            case JOBPHASE_POLL :
+               rcstep = job->backend->status(tr, job);
+               break;
+            case JOBPHASE_RESULTS :
+               rcstep = job->backend->results(tr, job);
+               break;
+            default :
+               rcstep = job->backend->submit(tr, job);
+               break;
+         }
+         if( rcstep != RETURN_OK )
+            job->phase = JOBPHASE_DONE;
+
+         if( job->phase == JOBPHASE_DONE )
+            ++ndone;
+         else if( !job->busy )
+         {
+            /* the step finished without a request in flight, e.g., by the local backend, so do not wait longer than until the next one is due */
+            wait = fmax(0.0, fmin(wait, job->nextrequest - now));
+         }
+      }
+
+      if( ndone == njobs )
+         break;
+
+      if( race )
+      {
+         for( j = 0; j < njobs; ++j )
+            if( jobs[j].phase == JOBPHASE_DONE && jobisoptimal(&jobs[j]) )
+               break;
+         if( j < njobs )
+         {
+            endrace(se, tr, jobs, njobs, j);
+            break;
+         }
+      }
+
+      if( gevTerminateGet(se->gev) )
+      {
+         gevLog(se->gev, "User Interrupt.\n");
+         gmoModelStatSet(se->gmo, gmoModelStat_NoSolutionReturned);
+         gmoSolveStatSet(se->gmo, gmoSolveStat_User);
+         break;
+      }
+
+      /* progress transfers, wait for activity or until next poll is due */
+      if( transferPerform(tr, (int)(1000 * wait)) != RETURN_OK )
+      {
+         gevLogStat(se->gev, "Error in curl_multi_perform()\n");
+         goto TERMINATE;
+      }
+   }
+
+   rc = RETURN_OK;
+TERMINATE:
+   /* abort transfers that are still in flight */
+   transferFree(&tr);
+   for( j = 0; j < njobs; ++j )
+      jobs[j].busy = 0;
+
+   return rc;
+}
+
+/* sets model and solve status according to status of results */
+static
+void setsolvestatus(
+   gamsse_t*   se,
+   const char* status
+   )
+{
+   gevHandle_t gev = se->gev;
+   gmoHandle_t gmo = se->gmo;
+
+   if( strcmp(status, "optimal") == 0 )
+   {
+      gmoModelStatSet(gmo, gmoModelStat_OptimalGlobal);
+      gmoSolveStatSet(gmo, gmoSolveStat_Normal);
+   }
+   else if( strcmp(status, "timeout") == 0 ) /* ??? cannot get here so far */
+   {
+      gmoModelStatSet(gmo, gmoNDisc(gmo) > 0 ? gmoModelStat_Integer : gmoModelStat_Feasible);
+      gmoSolveStatSet(gmo, gmoSolveStat_Resource);
+   }
+   else if( strcmp(status, "infeasible") == 0 )
+   {
+      gmoModelStatSet(gmo, gmoModelStat_InfeasibleGlobal);
+      gmoSolveStatSet(gmo, gmoSolveStat_Normal);
+   }
+   else if( strcmp(status, "unbounded") == 0 )
+   {
+      gmoModelStatSet(gmo, gmoModelStat_UnboundedNoSolution);
+      gmoSolveStatSet(gmo, gmoSolveStat_Normal);
+   }
+   else if( strcmp(status, "error") == 0 || strcmp(status, "unknown") == 0 )
+   {
+      /* some error on Satalia side */
+      gmoModelStatSet(gmo, gmoModelStat_ErrorNoSolution);
+      gmoSolveStatSet(gmo, gmoSolveStat_SolverErr);
+   }
+   else
+   {
+      /* unexpected status code
+       * we didn't check for "satisfiable" above, but this is for SAT only
+       */
+      gevLogStat(gev, "Unexpected status code.");
+      gmoModelStatSet(gmo, gmoModelStat_ErrorNoSolution);
+      gmoSolveStatSet(gmo, gmoSolveStat_SystemErr);
+   }
+}
+
+/** checks how much the solution that has been stored in GMO violates bounds and rows, and reports it in the log */
+static
+void checksolution(
+   gamsse_t* se
+   )
+{
+   gevHandle_t gev = se->gev;
+   gmoHandle_t gmo = se->gmo;
+   char strbuffer[1024];
+   char name[GMS_SSSIZE];
+   modelsnapviol_t viol;
+   double* levels = NULL;
+
+   if( !se->checksolution )
+      return;
+
+   if( se->modelsnap == NULL && modelsnapCreate(&se->modelsnap, gmo) != RETURN_OK )
+   {
+      gevLogStat(gev, "checksolution: Out of memory.");
+      goto TERMINATE;
+   }
+
+   levels = (double*) malloc((gmoN(gmo) + 1) * sizeof(double));
+   if( levels == NULL )
+   {
+      gevLogStat(gev, "checksolution: Out of memory.");
+      goto TERMINATE;
+   }
+   gmoGetVarL(gmo, levels);
+
+   if( modelsnapCheckPoint(se->modelsnap, levels, se->checktol, se->checkthreads, NULL, &viol) != RETURN_OK )
+   {
+      gevLogStat(gev, "checksolution: Out of memory.");
+      goto TERMINATE;
+   }
+
+   *name = '\0';
+   if( viol.maxboundvar >= 0 )
+      convertGetVarName(gmo, viol.maxboundvar, name);
+   sprintf(strbuffer, "Maximal bound violation: %9.2e %-12s %d variables violated by more than %g\n",
+      viol.maxboundviol, name, viol.nboundviol, se->checktol);
+   gevLogPChar(gev, strbuffer);
+
+   *name = '\0';
+   if( viol.maxrowidx >= 0 )
+      convertGetEquName(gmo, viol.maxrowidx, name);
+   sprintf(strbuffer, "Maximal row violation:   %9.2e %-12s %d rows violated by more than %g\n",
+      viol.maxrowviol, name, viol.nrowviol, se->checktol);
+   gevLogPChar(gev, strbuffer);
+
+   if( viol.nrowsskipped > 0 )
+   {
+      sprintf(strbuffer, "%d nonlinear or special rows have not been checked.\n", viol.nrowsskipped);
+      gevLogPChar(gev, strbuffer);
+   }
+
+   if( viol.nboundviol > 0 || viol.nrowviol > 0 )
+   {
+      sprintf(strbuffer, "Warning: Solution from SolveEngine violates %d bounds and %d rows by more than %g.",
+         viol.nboundviol, viol.nrowviol, se->checktol);
+      gevLogStat(gev, strbuffer);
+   }
+
+TERMINATE:
+   free(levels);
+}
+
+/* sets model and solve status for the incumbent of a job that has been stopped by a stop rule of the link */
+static
+void setstoppedstatus(
+   gamsse_t*   se,
+   JOBSTOP     stop
+   )
+{
+   gmoHandle_t gmo = se->gmo;
+
+   gmoModelStatSet(gmo, gmoNDisc(gmo) > 0 ? gmoModelStat_Integer : gmoModelStat_Feasible);
+   gmoSolveStatSet(gmo, stop == JOBSTOP_GAP ? gmoSolveStat_Normal : gmoSolveStat_Resource);
+}
+
+/** whether a variable is in the problem that has been submitted for a block, or for the complete instance if block is -1 */
+static
+int issubmittedvar(
+   gamsse_t* se,
+   int       block,
+   int       i
+   )
+{
+   if( se->presolve != NULL && se->presolve->colremoved[i] )
+      return 0;
+
+   return block < 0 || se->decomp->colblock[i] == block;
+}
+
+/** gives the number of variables in the problem that has been submitted for a block, or for the complete instance if block is -1,
+ * which a solution needs to have
+ */
+static
+int getnsubmittedvars(
+   gamsse_t* se,
+   int       block
+   )
+{
+   if( block >= 0 )
+      return se->decomp->ncols[block];
+
+   return se->presolve != NULL ? presolveGetNCols(se->presolve) : gmoN(se->gmo);
+}
+
+/** gives the name of a file of the local solver in the scratch directory */
+static
+void getlocalfilename(
+   gamsse_t*   se,
+   const char* extension,
+   char*       buffer        /**< buffer to store name, must have length at least GMS_SSSIZE + 20 */
+   )
+{
+   gevGetStrOpt(se->gev, gevNameScrDir, buffer);
+   strcat(buffer, "selocal.");
+   strcat(buffer, extension);
+}
+
+/** writes the problem of a job into an .lp file and starts the local solver on it */
+static
+RETURN localsubmit(
+   transfer_t* tr,
+   sejob_t*    job
+   )
+{
+   gamsse_t* se = job->se;
+   char lpfile[GMS_SSSIZE+20];
+   char solfile[GMS_SSSIZE+20];
+   char command[GMS_SSSIZE];
+   char strbuffer[GMS_SSSIZE+50];
+   FILE* f;
+   RETURN rc;
+
+   assert(job->block < 0);
+
+   getlocalfilename(se, "lp", lpfile);
+   getlocalfilename(se, "sol", solfile);
+
+   /* a solution file of an earlier solve must not be taken for the one of this solve */
+   remove(solfile);
+
+   f = fopen(lpfile, "w");
+   if( f == NULL )
+   {
+      gevLogStatPChar(se->gev, "Could not open file ");
+      gevLogStat(se->gev, lpfile);
+      return RETURN_ERROR;
+   }
+   rc = writeLP(se->gmo, se->gev, se->presolve, NULL, -1, writefile, f);
+   if( fclose(f) != 0 && rc == RETURN_OK )
+      rc = RETURN_ERROR_WRITEFUNC;
+   if( rc != RETURN_OK )
+   {
+      gevLogStatPChar(se->gev, "Error writing problem to ");
+      gevLogStat(se->gev, lpfile);
+      return RETURN_ERROR;
+   }
+
+   optGetStrStr(se->opt, "localsolver", command);
+   if( localsolveStart(&job->local, command, lpfile, solfile, se->debug) != RETURN_OK )
+   {
+      gevLogStatPChar(se->gev, "Could not start local solver: ");
+      gevLogStat(se->gev, command);
+      return RETURN_ERROR;
+   }
+
+   sprintf(strbuffer, "Solving locally: %s", command);
+   logjob(job, strbuffer);
+
+   job->starttime = gevTimeDiffStart(se->gev);
+   job->nextrequest = job->starttime + LOCALPOLLINTERVAL;
+   job->lastimprove = job->starttime;
+   job->bound = NAN;
+   job->gap = NAN;
+   job->status = JOBSTATUS_STARTED;
+   job->phase = JOBPHASE_POLL;
+
+   return RETURN_OK;
+}
+
+/** checks whether the local solver of a job has finished */
+static
+RETURN localstatus(
+   transfer_t* tr,
+   sejob_t*    job
+   )
+{
+   gamsse_t* se = job->se;
+   char strbuffer[1024];
+   int exitcode;
+
+   if( localsolveIsRunning(job->local, &exitcode) )
+   {
+      job->nextrequest += LOCALPOLLINTERVAL;
+      return RETURN_OK;
+   }
+
+   job->status = exitcode == 0 ? JOBSTATUS_COMPLETED : JOBSTATUS_FAILED;
+
+   sprintf(strbuffer, "%8.1fs Job %s%sStatus: %s\n", gevTimeDiffStart(se->gev) - job->starttime,
+      job->name != NULL ? job->name : "", job->name != NULL ? " " : "", jobstatusname[job->status]);
+   gevLogPChar(se->gev, strbuffer);
+
+   if( exitcode != 0 )
+   {
+      sprintf(strbuffer, "Local solver failed with exit code %d.", exitcode);
+      logjob(job, strbuffer);
+      job->phase = JOBPHASE_DONE;
+   }
+   else
+      job->phase = JOBPHASE_RESULTS;
+
+   return RETURN_OK;
+}
+
+/** reads the solution file of the local solver of a job into results of the form that SolveEngine gives
+ *
+ * The solution file lists only the variables with nonzero value, so the others are added with value zero.
+ */
+static
+RETURN localresults(
+   transfer_t* tr,
+   sejob_t*    job
+   )
+{
+   gamsse_t* se = job->se;
+   gmoHandle_t gmo = se->gmo;
+   char solfile[GMS_SSSIZE+20];
+   char name[GMS_SSSIZE];
+   cJSON* variables;
+   cJSON* var;
+   cJSON* next;
+   char* listed;
+   int i;
+
+   getlocalfilename(se, "sol", solfile);
+   if( localsolveReadSolution(solfile, &job->results) != RETURN_OK )
+   {
+      gevLogStatPChar(se->gev, "Could not read solution file ");
+      gevLogStat(se->gev, solfile);
+      return RETURN_ERROR;
+   }
+   job->phase = JOBPHASE_DONE;
+
+   variables = cJSON_GetObjectItem(cJSON_GetObjectItem(job->results, "result"), "variables");
+   if( variables == NULL )
+      return RETURN_OK;
+
+   listed = (char*) calloc(gmoN(gmo) + 1, sizeof(char));
+   if( listed == NULL )
+   {
+      cJSON_Delete(job->results);
+      job->results = NULL;
+      gevLogStat(se->gev, "getsolution: Out of memory.");
+      return RETURN_ERROR;
+   }
+
+   /* leave out what is not one of our variables, e.g., rows that some solvers list as well */
+   for( var = variables->child; var != NULL; var = next )
+   {
+      cJSON* item = cJSON_GetObjectItem(var, "name");
+
+      next = var->next;
+      i = convertParseVarIdx(item->valuestring);
+      if( i >= 0 && i < gmoN(gmo) && issubmittedvar(se, job->block, i) && !listed[i] )
+      {
+         convertGetVarName(gmo, i, name);
+         if( strcmp(name, item->valuestring) == 0 )
+         {
+            listed[i] = 1;
+            continue;
+         }
+      }
+      cJSON_Delete(cJSON_DetachItemViaPointer(variables, var));
+   }
+
+   for( i = 0; i < gmoN(gmo); ++i )
+   {
+      if( listed[i] || !issubmittedvar(se, job->block, i) )
+         continue;
+
+      var = cJSON_CreateObject();
+      convertGetVarName(gmo, i, name);
+      if( var == NULL || cJSON_AddStringToObject(var, "name", name) == NULL || cJSON_AddNumberToObject(var, "value", 0.0) == NULL )
+      {
+         cJSON_Delete(var);
+         free(listed);
+         cJSON_Delete(job->results);
+         job->results = NULL;
+         gevLogStat(se->gev, "getsolution: Out of memory.");
+         return RETURN_ERROR;
+      }
+      cJSON_AddItemToArray(variables, var);
+   }
+
+   free(listed);
+
+   return RETURN_OK;
+}
+
+/** asks the local solver of a job to terminate */
+static
+void localstop(
+   sejob_t* job
+   )
+{
+   if( job->local != NULL )
+      localsolveStop(job->local);
+}
+
+/** a command-line solver that runs on the local machine, which avoids the overhead of a SolveEngine job for small models */
+static const backend_t localbackend = { "local solver", localsubmit, localstatus, localresults, localstop };
+
+/** logs a line in the status file, prefixed by the name of the job if there are several */
+static
+void logjobstat(
+   sejob_t*    job,
+   const char* msg
+   )
+{
+   if( job->name != NULL )
+   {
+      gevLogStatPChar(job->se->gev, job->name);
+      gevLogStatPChar(job->se->gev, ": ");
+   }
+   gevLogStat(job->se->gev, msg);
+}
+
+/** reads status, objective value, and the levels of the submitted variables from the results of a job
+ *
+ * The results are either the response that has been parsed by cJSON or the ones that the solution reader has read.
+ * Levels of variables that have not been submitted with the job are not changed.
+ */
+static
+RETURN readsolution(
+   gamsse_t*    se,
+   sejob_t*     job,
+   double*      levels,       /**< array of length gmoN to store levels of submitted variables */
+   const char** status,       /**< to store status of results */
+   double*      objval,       /**< to store objective value, or NAN if results have none */
+   int*         hassolution   /**< to store whether results have a solution */
+   )
+{
+   gevHandle_t gev = se->gev;
+   gmoHandle_t gmo = se->gmo;
+   char strbuffer[1024];
+   cJSON* variables = NULL;
+   int nvars = -1;
+   int i;
+
+   *status = NULL;
+   *objval = NAN;
+   *hassolution = 0;
+
+   if( job->results != NULL )
+   {
+      cJSON* results;
+      cJSON* item;
+
+      results = cJSON_GetObjectItem(job->results, "result");
+      if( results == NULL )
+      {
+         gevLogStat(gev, "getsolution: No 'result' in solution from SolveEngine");
+         return RETURN_ERROR;
+      }
+
+      item = cJSON_GetObjectItem(results, "status");
+      if( item != NULL && cJSON_IsString(item) )
+         *status = item->valuestring;
+
+      item = cJSON_GetObjectItem(results, "objective_value");
+      if( item != NULL && cJSON_IsNumber(item) )
+         *objval = item->valuedouble;
+
+      variables = cJSON_GetObjectItem(results, "variables");
+      if( variables != NULL && cJSON_IsArray(variables) )
+         nvars = cJSON_GetArraySize(variables);
+   }
+   else
+   {
+      *status = solreaderGetStatus(job->solreader);
+      if( !solreaderGetObjective(job->solreader, objval) )
+         *objval = NAN;
+      nvars = solreaderGetNVars(job->solreader);
+   }
+
+   if( *status == NULL )
+   {
+      gevLogStat(gev, "getsolution: No 'status' in solution from SolveEngine");
+      return RETURN_ERROR;
+   }
+
+   sprintf(strbuffer, "Status: %s", *status);
+   logjobstat(job, strbuffer);
+
+   if( !isnan(*objval) )
+   {
+      sprintf(strbuffer, "Objective Value: %.10e", *objval);
+      logjobstat(job, strbuffer);
+   }
+
+   if( nvars < 0 )
+      return RETURN_OK;
+
+   if( nvars != getnsubmittedvars(se, job->block) )
+   {
+      sprintf(strbuffer, "Number of variables in solution (%d) does not match GAMS instance (%d).", nvars, getnsubmittedvars(se, job->block));
+      gevLogStat(gev, strbuffer);
+      return RETURN_ERROR;
+   }
+
+   if( job->results != NULL )
+   {
+      cJSON* varvalpair;
+      cJSON* varname;
+      cJSON* val;
+      int varidx;
+
+      /* walk the list of array elements once; cJSON_GetArrayItem() would start from the beginning each time */
+      cJSON_ArrayForEach(varvalpair, variables)
+      {
+         varname = cJSON_GetObjectItem(varvalpair, "name");
+         if( varname == NULL || !cJSON_IsString(varname) || strlen(varname->valuestring) < 2 )
+         {
+            gevLogStat(gev, "getsolution: No 'name' in variable result.");
+            return RETURN_ERROR;
+         }
+
+         val = cJSON_GetObjectItem(varvalpair, "value");
+         if( val == NULL || !cJSON_IsNumber(val) )
+         {
+            gevLogStat(gev, "getsolution: No 'value' in variable result.");
+            return RETURN_ERROR;
+         }
+
+         varidx = convertParseVarIdx(varname->valuestring);
+         if( varidx < 0 || varidx >= gmoN(gmo) || !issubmittedvar(se, job->block, varidx) )
+         {
+            gevLogStatPChar(gev, "Error parsing variable result ");
+            gevLogStat(gev, varname->valuestring);
+            return RETURN_ERROR;
+         }
+
+         levels[varidx] = val->valuedouble;
+      }
+   }
+   else
+   {
+      const double* readlevels = solreaderGetLevels(job->solreader);
+
+      for( i = 0; i < gmoN(gmo); ++i )
+         if( issubmittedvar(se, job->block, i) )
+            levels[i] = readlevels[i];
+   }
+
+   *hassolution = 1;
+
+   return RETURN_OK;
+}
+
+/** passes a solution to GMO and sets model and solve status */
+static
+void setsolution(
+   gamsse_t*   se,
+   double*     levels,       /**< levels of submitted variables, or NULL if there is no solution */
+   const char* status,       /**< status of results */
+   JOBSTOP     stop,         /**< stop rule that applied to a job, or JOBSTOP_NONE */
+   double      bound         /**< bound on objective value as reported for a stopped job, or NAN */
+   )
+{
+   gevHandle_t gev = se->gev;
+   gmoHandle_t gmo = se->gmo;
+
+   if( levels != NULL )
+   {
+      gevLog(gev, "Solution available.");
+
+      if( se->presolve != NULL )
+         presolveRestoreLevels(se->presolve, levels);
+      gmoSetVarL(gmo, levels);
+
+      gmoSetHeadnTail(gmo, gmoHmarginals, 0);
+      gmoCompleteSolution(gmo);
+      /* set mipbest (dual bound) to objval (primal bound), as we believe to be optimal, unless we stopped the job */
+      if( stop != JOBSTOP_NONE && !isnan(bound) )
+         gmoSetHeadnTail(gmo, gmoTmipbest, bound);
+      else
+         gmoSetHeadnTail(gmo, gmoTmipbest, gmoGetHeadnTail(gmo, gmoHobjval));
+
+      checksolution(se);
+   }
+   else
+   {
+      gevLog(gev, "No solution available.");
+   }
+
+   if( levels != NULL && stop != JOBSTOP_NONE && strcmp(status, "optimal") != 0 )
+      setstoppedstatus(se, stop);
+   else
+      setsolvestatus(se, status);
+}
+
+/* solution */
+static
+void getsolution(
+   gamsse_t* se,
+   sejob_t*  job
+   )
+{
+   const char* status;
+   double* levels;
+   double objval;
+   int hassolution;
+
+   levels = (double*) calloc(gmoN(se->gmo) + 1, sizeof(double));
+   if( levels == NULL )
+   {
+      gevLogStat(se->gev, "getsolution: Out of memory.");
+      return;
+   }
+
+   if( readsolution(se, job, levels, &status, &objval, &hassolution) == RETURN_OK )
+      setsolution(se, hassolution ? levels : NULL, status, job->stop, job->bound);
+
+   free(levels);
+}
+
+/** loads the solution from the result cache, if the problem has been solved before, and gives whether this has been done */
+static
+int getcachedsolution(
+   gamsse_t* se
+   )
+{
+   char strbuffer[1024];
+   sejob_t job;
+   char* data;
+   size_t length;
+   int nhits;
+   int nmisses;
+   int done = 0;
+
+   if( !resultcacheLoad(se->cache, se->cachekey, &data, &length, &nhits, &nmisses) )
+   {
+      sprintf(strbuffer, "Result cache miss for %s (%d hits, %d misses).", se->cachekey, nhits, nmisses);
+      gevLog(se->gev, strbuffer);
+      return 0;
+   }
+
+   sprintf(strbuffer, "Result cache hit for %s (%d hits, %d misses), not submitting job.", se->cachekey, nhits, nmisses);
+   gevLog(se->gev, strbuffer);
+
+   memset(&job, 0, sizeof(sejob_t));
+   job.se = se;
+   job.block = -1;
+
+   if( solreaderCreate(&job.solreader, gmoN(se->gmo)) != RETURN_OK )
+      gevLogStat(se->gev, "getsolution: Out of memory.");
+   else if( solreaderReadIndexed(job.solreader, data, length) != RETURN_OK )
+   {
+      gevLogStatPChar(se->gev, "Ignoring unreadable result cache entry: ");
+      gevLogStat(se->gev, solreaderGetError(job.solreader));
+   }
+   else
+   {
+      getsolution(se, &job);
+      gmoSetHeadnTail(se->gmo, gmoHresused, 0.0);
+      done = 1;
+   }
+
+   solreaderFree(&job.solreader);
+   free(data);
+
+   return done;
+}
+
+/** stores the results of a job in the result cache, in the format of a SolveEngine results response */
+static
+void storecachedsolution(
+   gamsse_t* se,
+   sejob_t*  job
+   )
+{
+   char strbuffer[1024];
+   buffer_t entry = BUFFERINIT;
+   char* printed = NULL;
+   const char* data;
+   size_t length;
+   int nevicted;
+
+   if( job->results != NULL )
+   {
+      printed = cJSON_PrintUnformatted(job->results);
+      if( printed == NULL )
+         return;
+      data = printed;
+      length = strlen(printed);
+   }
+   else
+   {
+      solreader_t* reader = job->solreader;
+      double objval;
+      int i;
+
+      assert(job->resultsread);
+      assert(solreaderGetStatus(reader) != NULL);
+
+      snprintf(strbuffer, sizeof(strbuffer), "{\"result\":{\"status\":\"%s\"", solreaderGetStatus(reader));
+      appendbuffer(&entry, strbuffer);
+      if( solreaderGetObjective(reader, &objval) )
+      {
+         sprintf(strbuffer, ",\"objective_value\":%.17g", objval);
+         appendbuffer(&entry, strbuffer);
+      }
+      if( solreaderGetNVars(reader) >= 0 )
+      {
+         const double* levels = solreaderGetLevels(reader);
+         int first = 1;
+
+         /* the entry has the variables of the submitted problem, as the response of SolveEngine would have */
+         appendbuffer(&entry, ",\"variables\":[");
+         for( i = 0; i < gmoN(se->gmo); ++i )
+         {
+            char name[GMS_SSSIZE];
+
+            if( !issubmittedvar(se, -1, i) )
+               continue;
+
+            convertGetVarName(se->gmo, i, name);
+            sprintf(strbuffer, "%s{\"name\":\"%s\",\"value\":%.17g}", first ? "" : ",", name, levels[i]);
+            if( appendbuffer(&entry, strbuffer) == 0 )
+               break;
+            first = 0;
+         }
+         appendbuffer(&entry, "]");
+      }
+      if( appendbuffer(&entry, "}}") == 0 )
+      {
+         gevLog(se->gev, "Out of memory storing results in cache.");
+         exitbuffer(&entry);
+         return;
+      }
+      data = (const char*)entry.content;
+      length = entry.length;
+   }
+
+   if( resultcacheStore(se->cache, se->cachekey, data, length, &nevicted) != RETURN_OK )
+      gevLog(se->gev, "Could not store results in result cache.");
+   else if( nevicted > 0 )
+   {
+      sprintf(strbuffer, "Evicted %d least recently used entries from result cache.", nevicted);
+      gevLog(se->gev, strbuffer);
+   }
+
+   free(printed);
+   exitbuffer(&entry);
+}
+
+/** prepares an incremental submission of the instance
+ *
+ * Takes the vectors of the instance and reads those of the last submitted model with the same structure.
+ * Gives that model as base if the changes against it are few enough to be sent instead of the complete problem.
+ */
+static
+void preparedelta(
+   gamsse_t*      se,
+   const char*    dir,
+   modeldelta_t** base       /**< to store model that changes refer to, or NULL if complete problem needs to be sent */
+   )
+{
+   gevHandle_t gev = se->gev;
+   char strbuffer[1024];
+   int nentries;
+   int nchanges;
+
+   *base = NULL;
+
+   if( se->modelsnap == NULL && modelsnapCreate(&se->modelsnap, se->gmo) != RETURN_OK )
+   {
+      gevLog(gev, "Out of memory taking snapshot of instance, sending complete problem.");
+      return;
+   }
+
+   /* the snapshot holds only a gradient of a quadratic objective */
+   if( !modeldeltaIsSupported(se->modelsnap) || gmoObjNLNZ(se->gmo) > 0 )
+   {
+      gevLog(gev, "Changes can only be sent for linear models without SOS, sending complete problem.");
+      return;
+   }
+
+   if( modeldeltaCreate(&se->modeldelta, se->modelsnap) != RETURN_OK )
+   {
+      gevLog(gev, "Out of memory taking vectors of instance, sending complete problem.");
+      return;
+   }
+
+   if( modeldeltaLoad(base, dir, se->modeldelta->structkey) != RETURN_OK )
+      gevLog(gev, "Ignoring unreadable vectors of earlier model.");
+
+   if( *base != NULL && ((*base)->n != se->modeldelta->n || (*base)->m != se->modeldelta->m) )
+      modeldeltaFree(base);
+
+   if( *base == NULL )
+   {
+      gevLog(gev, "No earlier model with same structure, sending complete problem.");
+      return;
+   }
+
+   nentries = 3 * se->modeldelta->n + se->modeldelta->m + 1;
+   nchanges = modeldeltaCount(*base, se->modeldelta);
+   if( nchanges > DELTAMAXFRACTION * nentries )
+   {
+      sprintf(strbuffer, "%d of %d entries changed since earlier model, sending complete problem.", nchanges, nentries);
+      gevLog(gev, strbuffer);
+      modeldeltaFree(base);
+      return;
+   }
+
+   sprintf(strbuffer, "Sending %d of %d entries that changed since earlier model %s.", nchanges, nentries, (*base)->problemkey);
+   gevLog(gev, strbuffer);
+}
+
+/** reduces the instance before it is written, so that fixed variables, free, empty, and singleton rows are not submitted */
+static
+void presolveproblem(
+   gamsse_t* se
+   )
+{
+   gevHandle_t gev = se->gev;
+   char strbuffer[1024];
+
+   /* the problem that SolveEngine keeps needs to have all variables and rows, as changes refer to them */
+   if( se->modeldelta != NULL )
+   {
+      gevLog(gev, "Presolve is not applied when sending changes of models.");
+      return;
+   }
+
+   if( se->modelsnap == NULL && modelsnapCreate(&se->modelsnap, se->gmo) != RETURN_OK )
+   {
+      gevLog(gev, "Out of memory taking snapshot of instance, skipping presolve.");
+      return;
+   }
+
+   if( !presolveIsSupported(se->modelsnap) || gmoObjNLNZ(se->gmo) > 0 )
+   {
+      gevLog(gev, "Presolve is only applied to linear models, skipping presolve.");
+      return;
+   }
+
+   if( presolveCreate(&se->presolve, se->modelsnap, gmoPinf(se->gmo)) != RETURN_OK )
+   {
+      gevLog(gev, "Out of memory in presolve, skipping presolve.");
+      return;
+   }
+
+   /* let the solver report an infeasibility in terms of the complete problem */
+   if( se->presolve->infeasible )
+   {
+      gevLog(gev, "Presolve found the model to be infeasible, sending complete problem.");
+      presolveFree(&se->presolve);
+      return;
+   }
+
+   sprintf(strbuffer, "Presolve removed %d rows, %d columns, and %d nonzeros.",
+      se->presolve->nrowsremoved, se->presolve->ncolsremoved, se->presolve->nnzremoved);
+   gevLog(gev, strbuffer);
+}
+
+/* stop a started job */
+static
+void stopjob(
+   gamsse_t*   se,
+   const char* jobid
+   )
+{
+   gevHandle_t gev = se->gev;
+   char strbuffer[1024];
+
+   /* gevLog(gev, "Stop job"); */
+
+   if( resetCurl(se) != RETURN_OK )
+      goto TERMINATE;
+
+   assert(jobid != NULL);
+   snprintf(strbuffer, sizeof(strbuffer), "%s/jobs/%s/stop", se->apiurl, jobid);
+   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, strbuffer) );
+
+   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_CUSTOMREQUEST, "DELETE") );
+
+   /* perform HTTP request */
+   if( performCurl(se, "stop", jobid, 1, NULL) != RETURN_OK )
+      goto TERMINATE;
+
+   if( se->curlwritebuf.length > 2 )
+   {
+      /* something else went wrong */
+      gevLogStatPChar(gev, "stopjob: Failure stopping job: ");
+      gevLogStatPChar(gev, (char*)se->curlwritebuf.content);
+      gevLogStatPChar(gev, "\n");
+   }
+
+TERMINATE : ;
+}
+
+/* stop a started job, doesn't seem to delete the job */
+static
+void deletejob(
+   gamsse_t*   se,
+   const char* jobid
+   )
+{
+   gevHandle_t gev = se->gev;
+   char strbuffer[1024];
+
+   /* gevLog(gev, "Deleting job"); */
+
+   if( resetCurl(se) != RETURN_OK )
+      goto TERMINATE;
+
+   assert(jobid != NULL);
+   snprintf(strbuffer, sizeof(strbuffer), "%s/jobs/%s", se->apiurl, jobid);
+   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, strbuffer) );
+
+   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_CUSTOMREQUEST, "DELETE") );
+
+   /* perform HTTP request */
+   if( performCurl(se, "delete", jobid, 1, NULL) != RETURN_OK )
+      goto TERMINATE;
+
+   if( se->curlwritebuf.length > 2 )
+   {
+      /* something else went wrong */
+      gevLogStatPChar(gev, "deletejob: Failure deleting job: ");
+      gevLogStatPChar(gev, (char*)se->curlwritebuf.content);
+      gevLogStatPChar(gev, "\n");
+   }
+
+TERMINATE : ;
+}
+
+/** sets model and solve status for a job that did not complete, and stops it at SolveEngine if it is still running */
+static
+void finishjob(
+   gamsse_t* se,
+   sejob_t*  job
+   )
+{
+   switch( job->status )
+   {
+      case JOBSTATUS_TIMEOUT :
+         /* if job has reached timeout, then set status accordingly
+          * cannot get any solution in this case...
+          */
+         gmoModelStatSet(se->gmo, gmoModelStat_NoSolutionReturned);
+         gmoSolveStatSet(se->gmo, gmoSolveStat_Resource);
+         break;
+
+      case JOBSTATUS_STARTING :
+      case JOBSTATUS_STARTED :
+         /* if job has been interrupted (Ctrl+C), then stop it */
+         job->backend->stop(job);
+         break;
+
+      case JOBSTATUS_FAILED :
+         /* if job has failed, then return solver error (instead of system error) */
+         gmoSolveStatSet(se->gmo, gmoSolveStat_SolverErr);
+         break;
+
+      default :
+         break;
+   }
+}
+
+/** finds independent blocks of the instance, so that they can be solved by jobs of their own */
+static
+void decomposeproblem(
+   gamsse_t* se,
+   int       maxblocks
+   )
+{
+   gevHandle_t gev = se->gev;
+   gmoHandle_t gmo = se->gmo;
+   char strbuffer[1024];
+   int b;
+
+   if( se->modeldelta != NULL )
+   {
+      gevLog(gev, "Decomposition is not applied when sending changes of models.");
+      return;
+   }
+
+   /* the cache has one entry per submitted problem */
+   if( se->cache != NULL )
+   {
+      gevLog(gev, "Decomposition is not applied when results are cached.");
+      return;
+   }
+
+   /* SOS and a nonlinear objective couple variables that do not share a row */
+   if( gmoGetVarTypeCnt(gmo, gmovar_S1) > 0 || gmoGetVarTypeCnt(gmo, gmovar_S2) > 0 || gmoObjNLNZ(gmo) > 0 )
+   {
+      gevLog(gev, "Decomposition is not applied to models with SOS or nonlinear objective.");
+      return;
+   }
+
+   if( se->modelsnap == NULL && modelsnapCreate(&se->modelsnap, gmo) != RETURN_OK )
+   {
+      gevLog(gev, "Out of memory taking snapshot of instance, skipping decomposition.");
+      return;
+   }
+
+   if( decompCreate(&se->decomp, se->modelsnap,
+         se->presolve != NULL ? se->presolve->colremoved : NULL,
+         se->presolve != NULL ? se->presolve->rowremoved : NULL, maxblocks) != RETURN_OK )
+   {
+      gevLog(gev, "Out of memory in decomposition, skipping decomposition.");
+      return;
+   }
+
+   if( se->decomp->nblocks <= 1 )
+   {
+      gevLog(gev, "Model has no independent blocks.");
+      decompFree(&se->decomp);
+      return;
+   }
+
+   sprintf(strbuffer, "Model has %d independent blocks, submitting them as %d jobs.", se->decomp->ncomponents, se->decomp->nblocks);
+   gevLog(gev, strbuffer);
+   for( b = 0; b < se->decomp->nblocks; ++b )
+   {
+      sprintf(strbuffer, "Block %d: %d variables, %d rows, %d nonzeros.", b, se->decomp->ncols[b], se->decomp->nrows[b], se->decomp->nnz[b]);
+      gevLog(gev, strbuffer);
+   }
+}
+
+/** gives the rank of a status of results when combining the results of blocks, with 0 for the status that dominates all others */
+static
+int statusrank(
+   const char* status
+   )
+{
+   /* an infeasible block makes the instance infeasible, while an unbounded block only matters if all blocks are feasible */
+   static const char* ranked[] = { "infeasible", "error", "unknown", "unbounded", "timeout", "optimal" };
+   int i;
+
+   for( i = 0; i < (int)(sizeof(ranked) / sizeof(ranked[0])); ++i )
+      if( strcmp(status, ranked[i]) == 0 )
+         return i == 0 ? 0 : i + 1;
+
+   /* unexpected status ranks just after infeasible */
+   return 1;
+}
+
+/** combines the results of the jobs of all blocks into a solution of the instance
+ *
+ * The instance has a solution if each block has one, its status is the dominating status of the blocks,
+ * and its bound is the sum of the bounds of the blocks.
+ */
+static
+void getblocksolution(
+   gamsse_t* se,
+   sejob_t*  jobs,
+   int       njobs
+   )
+{
+   char strbuffer[1024];
+   const char* status = NULL;
+   JOBSTOP stop = JOBSTOP_NONE;
+   double bound = 0.0;
+   double* levels;
+   int hassolution = 1;
+   int j;
+
+   levels = (double*) calloc(gmoN(se->gmo) + 1, sizeof(double));
+   if( levels == NULL )
+   {
+      gevLogStat(se->gev, "getsolution: Out of memory.");
+      return;
+   }
+
+   for( j = 0; j < njobs; ++j )
+   {
+      const char* jobstatus;
+      double objval;
+      int jobhassolution;
+
+      if( jobs[j].results == NULL && !jobs[j].resultsread )
+      {
+         logjob(&jobs[j], "No results, so there is no solution for the instance.");
+         goto TERMINATE;
+      }
+
+      if( readsolution(se, &jobs[j], levels, &jobstatus, &objval, &jobhassolution) != RETURN_OK )
+         goto TERMINATE;
+
+      hassolution &= jobhassolution;
+      if( status == NULL || statusrank(jobstatus) < statusrank(status) )
+         status = jobstatus;
+
+      if( jobs[j].stop != JOBSTOP_NONE )
+      {
+         /* a block that stalled makes the stop a resource interrupt */
+         if( stop != JOBSTOP_NOIMPROVE )
+            stop = jobs[j].stop;
+         bound += jobs[j].bound;
+      }
+      else if( isfinite(objval) )
+         bound += objval;
+   }
+
+   if( status == NULL )
+      goto TERMINATE;
+
+   sprintf(strbuffer, "Status of instance: %s", status);
+   gevLogStat(se->gev, strbuffer);
+
+   setsolution(se, hassolution ? levels : NULL, status, stop, bound);
+
+TERMINATE:
+   free(levels);
+}
+
+/** solves the blocks of the instance by jobs of their own, which run in parallel, and combines their results */
+static
+void solveblocks(
+   gamsse_t* se
+   )
+{
+   int nblocks = se->decomp->nblocks;
+   buffer_t* problems;
+   sejob_t* jobs;
+   char* names;
+   double starttime;
+   int b;
+
+   problems = (buffer_t*) calloc(nblocks, sizeof(buffer_t));
+   jobs = (sejob_t*) calloc(nblocks, sizeof(sejob_t));
+   names = (char*) malloc(nblocks * 20);
+   if( problems == NULL || jobs == NULL || names == NULL )
+   {
+      gevLogStat(se->gev, "Out of memory.\n");
+      goto TERMINATE;
+   }
+
+   for( b = 0; b < nblocks; ++b )
+      if( buildproblem(se, &problems[b], NULL, b, NULL) != RETURN_OK )
+         goto TERMINATE;
+
+   finishprewarm(se);
+
+   for( b = 0; b < nblocks; ++b )
+   {
+      sprintf(names + 20 * b, "Block %d", b);
+      if( initjob(se, &jobs[b], names + 20 * b, &problems[b]) != RETURN_OK )
+         goto TERMINATE;
+      jobs[b].block = b;
+   }
+
+   if( runjobs(se, jobs, nblocks, 0) != RETURN_OK )
+      goto TERMINATE;
+
+   /* blocks that were not submitted have no start time */
+   starttime = INFINITY;
+   for( b = 0; b < nblocks; ++b )
+      if( jobs[b].jobid != NULL || jobs[b].starttime > 0.0 )
+         starttime = fmin(starttime, jobs[b].starttime);
+   if( isfinite(starttime) )
+      gmoSetHeadnTail(se->gmo, gmoHresused, gevTimeDiffStart(se->gev) - starttime);
+
+   getblocksolution(se, jobs, nblocks);
+
+   for( b = 0; b < nblocks; ++b )
+      finishjob(se, &jobs[b]);
+
+TERMINATE:
+   for( b = 0; jobs != NULL && b < nblocks; ++b )
+   {
+      if( jobs[b].jobid != NULL && optGetIntStr(se->opt, "deletejob") )
+         deletejob(se, jobs[b].jobid);
+      freejob(&jobs[b]);
+   }
+   for( b = 0; problems != NULL && b < nblocks; ++b )
+      exitbuffer(&problems[b]);
+
+   free(problems);
+   free(jobs);
+   free(names);
+}
+
+/** solves the instance by several jobs that differ in their options only, and uses the results of the first job that finishes optimally
+ *
+ * The problem is converted once and only the options at the begin of the submit request differ between the jobs.
+ * If the API implements problems that refer to earlier ones, then only the first job uploads the problem, under a key of the race,
+ * and the other jobs refer to it with no changes, so that they are submitted once the first job has been created.
+ * If no job finishes optimally, the results of the first job that has results are used.
+ */
+static
+void solverace(
+   gamsse_t* se
+   )
+{
+   int njobs = se->nraceoptions;
+   buffer_t problem = BUFFERINIT;
+   buffer_t* problems;
+   sejob_t* jobs;
+   char* names;
+   char strbuffer[1024];
+   char problemkey[40];
+   const char* mipstart = NULL;
+   const char* timeout;
+   size_t optionslength;
+   size_t mipstartlength = 0;
+   int winner = -1;
+   int j;
+
+   problems = (buffer_t*) calloc(njobs, sizeof(buffer_t));
+   jobs = (sejob_t*) calloc(njobs, sizeof(sejob_t));
+   names = (char*) malloc(njobs * 20);
+   if( problems == NULL || jobs == NULL || names == NULL )
+   {
+      gevLogStat(se->gev, "Out of memory.\n");
+      goto TERMINATE;
+   }
+
+   /* a new key for each race, as the problem kept under it has the presolve and MIP start of this solve */
+   makeidempotencykey(problemkey);
+   if( buildproblem(se, &problem, NULL, -1, se->apiextensions ? problemkey : NULL) != RETURN_OK )
+      goto TERMINATE;
+
+   /* the problem starts with the options, see buildproblem(), so replace them by the ones of each job */
+   optionslength = strlen("{\"options\":") + strlen(se->solveroptions != NULL ? se->solveroptions : "{}");
+   assert(problem.length > optionslength);
+
+   /* the problem ends with the MIP start, if any, the problem key, and the timeout, which the other jobs send with their reference */
+   if( se->apiextensions )
+   {
+      mipstart = strstr((char*)problem.content, ",{\"name\":\"problem.mst\"");
+      if( mipstart != NULL )
+      {
+         ++mipstart;
+         mipstartlength = strstr(mipstart, "],\"problem_key\"") - mipstart;
+      }
+   }
+   timeout = strstr((char*)problem.content, ",\"timeout\":");
+   assert(timeout != NULL);
+
+   sprintf(strbuffer, "Racing %d jobs with different solver options.", njobs);
+   gevLog(se->gev, strbuffer);
+   if( se->apiextensions )
+      gevLog(se->gev, "Uploading the problem with the first job, the other jobs refer to it.");
+   else
+      gevLog(se->gev, "SolveEngine does not implement problems that refer to earlier ones, so each job uploads the problem.");
+
+   for( j = 0; j < njobs; ++j )
+   {
+      sprintf(names + 20 * j, "Settings %d", j + 1);
+
+      if( ensurebuffer(&problems[j], problem.length - optionslength + strlen(se->raceoptions[j]) + 20) == 0 )
+      {
+         gevLogStat(se->gev, "Out of memory.\n");
+         goto TERMINATE;
+      }
+      appendbuffer(&problems[j], "{\"options\":");
+      appendbuffer(&problems[j], se->raceoptions[j]);
+      if( j == 0 || !se->apiextensions )
+         appendbuffer(&problems[j], (char*)problem.content + optionslength);
+      else
+      {
+         /* the problem of the first job without changes */
+         sprintf(strbuffer, ",\"base\":\"%s\",\"delta\":{},\"problems\":[", problemkey);
+         appendbuffer(&problems[j], strbuffer);
+         if( mipstartlength > 0 )
+         {
+            if( ensurebuffer(&problems[j], mipstartlength) < mipstartlength )
+            {
+               gevLogStat(se->gev, "Out of memory.\n");
+               goto TERMINATE;
+            }
+            memcpy((char*)problems[j].content + problems[j].length, mipstart, mipstartlength);
+            problems[j].length += mipstartlength;
+         }
+         appendbuffer(&problems[j], "]");
+         appendbuffer(&problems[j], (char*)timeout);
+      }
+
+      sprintf(strbuffer, "%s: %s", names + 20 * j, se->raceoptions[j]);
+      gevLog(se->gev, strbuffer);
+   }
+   exitbuffer(&problem);
+
+   finishprewarm(se);
+
+   for( j = 0; j < njobs; ++j )
+   {
+      if( initjob(se, &jobs[j], names + 20 * j, &problems[j]) != RETURN_OK )
+         goto TERMINATE;
+      if( j > 0 && se->apiextensions )
+         jobs[j].dependson = &jobs[0];
+   }
+
+   if( runjobs(se, jobs, njobs, 1) != RETURN_OK )
+      goto TERMINATE;
+
+   for( j = 0; j < njobs; ++j )
+   {
+      if( jobs[j].results == NULL && !jobs[j].resultsread )
+         continue;
+      if( jobisoptimal(&jobs[j]) )
+      {
+         winner = j;
+         break;
+      }
+      if( winner < 0 )
+         winner = j;
+   }
+
+   if( winner < 0 )
+   {
+      gevLog(se->gev, "No job of the race has results.");
+      for( j = 0; j < njobs; ++j )
+         finishjob(se, &jobs[j]);
+      goto TERMINATE;
+   }
+
+   sprintf(strbuffer, "Using results of %s.", names + 20 * winner);
+   gevLogStat(se->gev, strbuffer);
+
+   gmoSetHeadnTail(se->gmo, gmoHresused, gevTimeDiffStart(se->gev) - jobs[winner].starttime);
+
+   getsolution(se, &jobs[winner]);
+
+   /* jobs that lost the race are not needed anymore, so stop the ones that are still running */
+   for( j = 0; j < njobs; ++j )
+      if( j != winner && jobstatusisrunning(jobs[j].status) && !jobs[j].stopsent )
+         jobs[j].backend->stop(&jobs[j]);
+
+   finishjob(se, &jobs[winner]);
+
+TERMINATE:
+   /* jobs that lost the race are deleted in any case, as their results are of no use */
+   for( j = 0; jobs != NULL && j < njobs; ++j )
+   {
+      if( jobs[j].jobid != NULL && ((winner >= 0 && j != winner) || optGetIntStr(se->opt, "deletejob")) )
+         deletejob(se, jobs[j].jobid);
+      freejob(&jobs[j]);
+   }
+   for( j = 0; problems != NULL && j < njobs; ++j )
+      exitbuffer(&problems[j]);
+   exitbuffer(&problem);
+
+   free(problems);
+   free(jobs);
+   free(names);
+}
+
+/** whether the instance is small enough to be solved by the local solver instead of SolveEngine */
+static
+int uselocalsolver(
+   gamsse_t* se
+   )
+{
+   int maxnz = optGetIntStr(se->opt, "localmaxnz");
+
+   if( maxnz <= 0 || gmoNZ(se->gmo) > maxnz )
+      return 0;
+
+   /* the local solver gets the .lp file that SolveEngine would get, but is not expected to handle quadratic terms */
+   if( gmoNLNZ(se->gmo) > 0 || gmoObjNLNZ(se->gmo) > 0 )
+      return 0;
+
+   return 1;
+}
+
+/** solves the instance by the local solver, which runs as a job with the local backend */
+static
+void solvelocal(
+   gamsse_t* se
+   )
+{
+   char filename[GMS_SSSIZE+20];
+   sejob_t job;
+
+   if( initjob(se, &job, NULL, NULL) != RETURN_OK )
+      goto TERMINATE;
+   job.backend = &localbackend;
+
+   if( runjobs(se, &job, 1, 0) != RETURN_OK )
+      goto TERMINATE;
+
+   gmoSetHeadnTail(se->gmo, gmoHresused, gevTimeDiffStart(se->gev) - job.starttime);
+
+   if( job.results != NULL )
+      getsolution(se, &job);
+
+   finishjob(se, &job);
+
+TERMINATE:
+   freejob(&job);
+
+   /* keep the files for inspection when debugging */
+   if( !se->debug )
+   {
+      getlocalfilename(se, "lp", filename);
+      remove(filename);
+      getlocalfilename(se, "sol", filename);
+      remove(filename);
+   }
+}
+
+/** parses a comma-separated list of name=value pairs of solver parameters into a JSON object
+ *
+ * Values that are numbers or true/false are passed as such, all other values as strings.
+ * Names must consist of letters, digits, and the characters _.- and must not be repeated.
+ */
+static
+RETURN parsesolveroptions(
+   gevHandle_t gev,
+   const char* list,
+   char**      json          /**< to store JSON object, must be freed by caller */
+)
+{
+   cJSON* options;
+   cJSON* item;
+   char strbuffer[2*GMS_SSSIZE];
+   char name[GMS_SSSIZE];
+   char value[GMS_SSSIZE];
+   RETURN rc = RETURN_ERROR;
+
+   assert(list != NULL);
+   assert(json != NULL);
+
+   *json = NULL;
+
+   options = cJSON_CreateObject();
+   if( options == NULL )
+      return RETURN_ERROR;
+
+   while( *list != '\0' )
+   {
+      const char* begin;
+      const char* end;
+      const char* eq;
+      const char* nameend;
+      char* numend;
+      double num;
+
+      while( *list == ' ' || *list == ',' )
+         ++list;
+      if( *list == '\0' )
+         break;
+
+      begin = list;
+      end = list;
+      while( *end != '\0' && *end != ',' )
+         ++end;
+      list = end;
+
+      while( end > begin && end[-1] == ' ' )
+         --end;
+
+      eq = begin;
+      while( eq < end && *eq != '=' )
+         ++eq;
+      if( eq == end )
+      {
+         sprintf(strbuffer, "Solver option '%.*s' is not of the form name=value.", (int)(end - begin), begin);
+         gevLogStat(gev, strbuffer);
+         goto TERMINATE;
+      }
+
+      nameend = eq;
+      while( nameend > begin && nameend[-1] == ' ' )
+         --nameend;
+      memcpy(name, begin, nameend - begin);
+      name[nameend - begin] = '\0';
+
+      ++eq;
+      while( eq < end && *eq == ' ' )
+         ++eq;
+      memcpy(value, eq, end - eq);
+      value[end - eq] = '\0';
+
+      if( *name == '\0' || strspn(name, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_.-") != strlen(name) )
+      {
+         sprintf(strbuffer, "Invalid name '%s' of solver option.", name);
+         gevLogStat(gev, strbuffer);
+         goto TERMINATE;
+      }
+      if( *value == '\0' )
+      {
+         sprintf(strbuffer, "Missing value for solver option '%s'.", name);
+         gevLogStat(gev, strbuffer);
+         goto TERMINATE;
+      }
+      if( cJSON_GetObjectItemCaseSensitive(options, name) != NULL )
+      {
+         sprintf(strbuffer, "Solver option '%s' given more than once.", name);
+         gevLogStat(gev, strbuffer);
+         goto TERMINATE;
+      }
+
+      num = strtod(value, &numend);
+      if( *numend == '\0' && isfinite(num) )
+         item = cJSON_CreateNumber(num);
+      else if( strcasecmp(value, "true") == 0 )
+         item = cJSON_CreateTrue();
+      else if( strcasecmp(value, "false") == 0 )
+         item = cJSON_CreateFalse();
+      else
+         item = cJSON_CreateString(value);
+
+      if( item == NULL )
+         goto TERMINATE;
+      cJSON_AddItemToObject(options, name, item);
+   }
+
+   *json = cJSON_PrintUnformatted(options);
+   if( *json == NULL )
+      goto TERMINATE;
+
+   rc = RETURN_OK;
+
+TERMINATE :
+   cJSON_Delete(options);
+
+   return rc;
+}
+
+/** builds the body of the submit request of a scenario, which sends the changes of the scenario against the problem of the instance
+ *
+ * The problem of the instance is the one that buildproblem() submits with the problem key of se->modeldelta.
+ */
+static
+RETURN buildscenario(
+   gamsse_t*           se,
+   buffer_t*           problem,
+   const modeldelta_t* scenario
+   )
+{
+   buffer_t body = BUFFERINIT;
+   char strbuffer[GMS_SSSIZE];
+   int timelimit;
+
+   assert(se->modeldelta != NULL);
+
+   /* same time limit as in buildproblem(), which logs the adjustment */
+   timelimit = (int)gevGetDblOpt(se->gev, gevResLim);
+   if( timelimit < 60 )
+      timelimit = 60;
+
+   appendbuffer(&body, "{\"options\":");
+   appendbuffer(&body, se->solveroptions != NULL ? se->solveroptions : "{}");
+   sprintf(strbuffer, ",\"base\":\"%s\",\"delta\":", se->modeldelta->problemkey);
+   appendbuffer(&body, strbuffer);
+   if( modeldeltaWriteJSON(se->modeldelta, scenario, gmoPinf(se->gmo), appendbufferWrite, &body) != RETURN_OK )
+      goto OUTOFMEMORY;
+   sprintf(strbuffer, ",\"problems\":[],\"timeout\": %d}", timelimit);
+   if( appendbuffer(&body, strbuffer) == 0 )
+      goto OUTOFMEMORY;
+
+   *problem = body;
+
+   return RETURN_OK;
+
+OUTOFMEMORY:
+   gevLogStat(se->gev, "Out of memory converting scenario.");
+   exitbuffer(&body);
+
+   return RETURN_ERROR;
+}
+
+/** writes the status, objective value, and levels of all variables from the results of each scenario into a file in JSON format */
+static
+RETURN writescenarioresults(
+   gamsse_t*            se,
+   sejob_t*             jobs,      /**< jobs of the scenarios */
+   const scenarioset_t* set,
+   const char*          filename
+   )
+{
+   char strbuffer[GMS_SSSIZE+100];
+   cJSON* root = NULL;
+   cJSON* arr;
+   cJSON* item;
+   char* str = NULL;
+   double* levels;
+   FILE* file = NULL;
+   RETURN rc = RETURN_ERROR;
+   int nsolved = 0;
+   int s;
+
+   levels = (double*) calloc(gmoN(se->gmo) + 1, sizeof(double));
+   root = cJSON_CreateObject();
+   if( levels == NULL || root == NULL )
+      goto TERMINATE;
+
+   arr = cJSON_AddArrayToObject(root, "scenarios");
+   for( s = 0; s < set->nscenarios; ++s )
+   {
+      const char* status;
+      double objval;
+      int hassolution;
+
+      item = cJSON_CreateObject();
+      cJSON_AddItemToArray(arr, item);
+      cJSON_AddStringToObject(item, "name", set->scenarios[s].name);
+
+      if( jobs[s].results == NULL && !jobs[s].resultsread )
+      {
+         /* status of the job, e.g., failed */
+         cJSON_AddStringToObject(item, "status", jobstatusname[jobs[s].status]);
+         continue;
+      }
+
+      if( readsolution(se, &jobs[s], levels, &status, &objval, &hassolution) != RETURN_OK )
+      {
+         cJSON_AddStringToObject(item, "status", "error");
+         continue;
+      }
+
+      cJSON_AddStringToObject(item, "status", status);
+      if( !isnan(objval) )
+         cJSON_AddNumberToObject(item, "objective_value", objval);
+      if( hassolution )
+      {
+         cJSON_AddItemToObject(item, "levels", cJSON_CreateDoubleArray(levels, gmoN(se->gmo)));
+         ++nsolved;
+      }
+   }
+
+   str = cJSON_PrintUnformatted(root);
+   if( str == NULL )
+      goto TERMINATE;
+
+   file = fopen(filename, "w");
+   if( file == NULL )
+      goto TERMINATE;
+
+   if( fputs(str, file) < 0 || fputc('\n', file) == EOF )
+      goto TERMINATE;
+
+   rc = RETURN_OK;
+
+TERMINATE:
+   if( file != NULL && fclose(file) != 0 )
+      rc = RETURN_ERROR;
+   cJSON_free(str);
+   cJSON_Delete(root);
+   free(levels);
+
+   if( rc == RETURN_OK )
+      sprintf(strbuffer, "Wrote solutions of %d of %d scenarios to %.*s.", nsolved, set->nscenarios, GMS_SSSIZE, filename);
+   else
+      sprintf(strbuffer, "Error writing results of scenarios to %.*s.", GMS_SSSIZE, filename);
+   gevLogStat(se->gev, strbuffer);
 
-   return statusstr;
+   return rc;
 }
 
-/* solution */
+/** solves the instance and its scenarios by jobs that run in parallel
+ *
+ * The instance is submitted as a complete problem, which SolveEngine keeps, and each scenario as the changes against it,
+ * so the structure of the model is converted and uploaded once.
+ * The solution of the instance is passed to GMO, and the results of the scenarios are written to a file.
+ */
 static
-void getsolution(
-   gamsse_t* se
+void solvescenarios(
+   gamsse_t*   se,
+   const char* scenariofile
    )
 {
    gevHandle_t gev = se->gev;
-   gmoHandle_t gmo = se->gmo;
-   char strbuffer[1024];
-   cJSON* root = NULL;
-   cJSON* results = NULL;
-   cJSON* status = NULL;
-   cJSON* objval = NULL;
-   cJSON* variables = NULL;
-
-   gevLog(gev, "Retrieving results.");
-
-   if( resetCurl(se) != RETURN_OK )
-      goto TERMINATE;
+   char strbuffer[GMS_SSSIZE+100];
+   char errmsg[256];
+   scenarioset_t* set = NULL;
+   modeldelta_t* scenario = NULL;
+   buffer_t* problems = NULL;
+   sejob_t* jobs = NULL;
+   int njobs = 0;
+   int j;
 
-   assert(se->jobid != NULL);
-   sprintf(strbuffer, "https://solve.satalia.com/api/v2/jobs/%s/results", se->jobid);
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, strbuffer) );
+   if( se->modelsnap == NULL && modelsnapCreate(&se->modelsnap, se->gmo) != RETURN_OK )
+   {
+      gevLogStat(gev, "Out of memory.\n");
+      return;
+   }
 
-   /* get a progress report since this can take time for larger problems */
-   se->progresslastruntime = 0;
-   se->progressisupload = 0;
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_XFERINFOFUNCTION, progressreportCurl) );
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_XFERINFODATA, se) );
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_NOPROGRESS, 0L) );
+   if( !modeldeltaIsSupported(se->modelsnap) || gmoObjNLNZ(se->gmo) > 0 )
+   {
+      gevLogStat(gev, "Scenarios are only supported for linear models.");
+      gmoModelStatSet(se->gmo, gmoModelStat_NoSolutionReturned);
+      gmoSolveStatSet(se->gmo, gmoSolveStat_Capability);
+      return;
+   }
 
-   /* perform HTTP request */
-   if( performCurl(se, &root) != RETURN_OK )
-      goto TERMINATE;
+   if( scenarioRead(&set, scenariofile, gmoN(se->gmo), gmoM(se->gmo), gmoPinf(se->gmo), errmsg) != RETURN_OK )
+   {
+      gevLogStatPChar(gev, "Error reading scenario file ");
+      gevLogStatPChar(gev, scenariofile);
+      gevLogStatPChar(gev, ": ");
+      gevLogStat(gev, errmsg);
+      return;
+   }
 
-   results = cJSON_GetObjectItem(root, "result");
-   if( results == NULL )
+   /* the problem key of the instance lets SolveEngine keep its problem, which the scenarios refer to */
+   if( modeldeltaCreate(&se->modeldelta, se->modelsnap) != RETURN_OK )
    {
-      gevLogStat(gev, "getsolution: No 'result' in solution from SolveEngine");
+      gevLogStat(gev, "Out of memory.\n");
       goto TERMINATE;
    }
 
-   status = cJSON_GetObjectItem(results, "status");
-   if( status == NULL || !cJSON_IsString(status) )
+   njobs = set->nscenarios + 1;
+   problems = (buffer_t*) calloc(njobs, sizeof(buffer_t));
+   jobs = (sejob_t*) calloc(njobs, sizeof(sejob_t));
+   if( problems == NULL || jobs == NULL )
    {
-      gevLogStat(gev, "getsolution: No 'status' in solution from SolveEngine");
+      gevLogStat(gev, "Out of memory.\n");
       goto TERMINATE;
    }
 
-   gevLogStatPChar(gev, "Status: ");
-   gevLogStat(gev, status->valuestring);
+   if( buildproblem(se, &problems[0], NULL, -1, se->modeldelta->problemkey) != RETURN_OK )
+      goto TERMINATE;
 
-   objval = cJSON_GetObjectItem(results, "objective_value");
-   if( objval != NULL && cJSON_IsNumber(objval) )
+   for( j = 1; j < njobs; ++j )
    {
-      sprintf(strbuffer, "Objective Value: %.10e\n", objval->valuedouble);
-      gevLogStatPChar(gev, strbuffer);
+      RETURN rc;
+
+      if( modeldeltaCopy(&scenario, se->modeldelta) != RETURN_OK )
+      {
+         gevLogStat(gev, "Out of memory.\n");
+         goto TERMINATE;
+      }
+      scenarioApply(&set->scenarios[j-1], scenario);
+      rc = buildscenario(se, &problems[j], scenario);
+      modeldeltaFree(&scenario);
+      if( rc != RETURN_OK )
+         goto TERMINATE;
    }
 
-   variables = cJSON_GetObjectItem(results, "variables");
-   if( variables != NULL && cJSON_IsArray(variables) )
-   {
-      cJSON* varvalpair;
-      cJSON* varname;
-      cJSON* val;
-      int i;
-      long int varidx;
-      char* endptr;
+   sprintf(strbuffer, "Submitting %d scenarios as changes against the instance.", set->nscenarios);
+   gevLog(gev, strbuffer);
 
-      gevLog(gev, "Solution available.");
+   finishprewarm(se);
 
-      if( cJSON_GetArraySize(variables) != gmoN(gmo) )
-      {
-         sprintf(strbuffer, "Number of variables in solution (%d) does not match GAMS instance (%d).", cJSON_GetArraySize(variables), gmoN(gmo));
-         gevLogStat(gev, strbuffer);
+   if( initjob(se, &jobs[0], "Instance", &problems[0]) != RETURN_OK )
+      goto TERMINATE;
+   for( j = 1; j < njobs; ++j )
+   {
+      if( initjob(se, &jobs[j], set->scenarios[j-1].name, &problems[j]) != RETURN_OK )
          goto TERMINATE;
-      }
+      jobs[j].dependson = &jobs[0];
+   }
 
-      for( i = 0; i < cJSON_GetArraySize(variables); ++i)
-      {
-         varvalpair = cJSON_GetArrayItem(variables, i);
-         assert(varvalpair != NULL);
+   if( runjobs(se, jobs, njobs, 0) != RETURN_OK )
+      goto TERMINATE;
 
-         varname = cJSON_GetObjectItem(varvalpair, "name");
-         if( varname == NULL || !cJSON_IsString(varname) || strlen(varname->valuestring) < 2 )
-         {
-            gevLogStat(gev, "getsolution: No 'name' in variable result.");
-            goto TERMINATE;
-         }
+   gmoSetHeadnTail(se->gmo, gmoHresused, gevTimeDiffStart(se->gev) - jobs[0].starttime);
 
-         val = cJSON_GetObjectItem(varvalpair, "value");
-         if( val == NULL || !cJSON_IsNumber(val) )
-         {
-            gevLogStat(gev, "getsolution: No 'value' in variable result.");
-            goto TERMINATE;
-         }
+   if( jobs[0].results != NULL || jobs[0].resultsread )
+      getsolution(se, &jobs[0]);
 
-         varidx = strtol(varname->valuestring+1, &endptr, 10);
-         if( *endptr != '\0' || varidx < 0 || varidx > gmoN(gmo) )
-         {
-            gevLogPChar(gev, "Error parsing variable result ");
-            gevLog(gev, cJSON_Print(varvalpair));
-         }
+   finishjob(se, &jobs[0]);
 
-         gmoSetVarLOne(gmo, varidx, val->valuedouble);
-      }
+   /* scenarios that are still running, e.g., after a user interrupt, are stopped */
+   for( j = 1; j < njobs; ++j )
+      if( jobstatusisrunning(jobs[j].status) && !jobs[j].stopsent )
+         jobs[j].backend->stop(&jobs[j]);
 
-      gmoSetHeadnTail(gmo, gmoHmarginals, 0);
-      gmoCompleteSolution(gmo);
-      /* set mipbest (dual bound) to objval (primal bound), as we believe to be optimal */
-      gmoSetHeadnTail(gmo, gmoTmipbest, gmoGetHeadnTail(gmo, gmoHobjval));
-   }
-   else
-   {
-      gevLog(gev, "No solution available.");
-   }
+   optGetStrStr(se->opt, "scenarioresults", strbuffer);
+   writescenarioresults(se, jobs + 1, set, strbuffer);
 
-   if( strcmp(status->valuestring, "optimal") == 0 )
-   {
-      gmoModelStatSet(gmo, gmoModelStat_OptimalGlobal);
-      gmoSolveStatSet(gmo, gmoSolveStat_Normal);
-   }
-   else if( strcmp(status->valuestring, "timeout") == 0 ) /* ??? cannot get here so far */
-   {
-      gmoModelStatSet(gmo, gmoNDisc(gmo) > 0 ? gmoModelStat_Integer : gmoModelStat_Feasible);
-      gmoSolveStatSet(gmo, gmoSolveStat_Resource);
-   }
-   else if( strcmp(status->valuestring, "infeasible") == 0 )
-   {
-      gmoModelStatSet(gmo, gmoModelStat_InfeasibleGlobal);
-      gmoSolveStatSet(gmo, gmoSolveStat_Normal);
-   }
-   else if( strcmp(status->valuestring, "unbounded") == 0 )
-   {
-      gmoModelStatSet(gmo, gmoModelStat_UnboundedNoSolution);
-      gmoSolveStatSet(gmo, gmoSolveStat_Normal);
-   }
-   else if( strcmp(status->valuestring, "error") == 0 || strcmp(status->valuestring, "unknown") == 0 )
-   {
-      /* some error on Satalia side */
-      gmoModelStatSet(gmo, gmoModelStat_ErrorNoSolution);
-      gmoSolveStatSet(gmo, gmoSolveStat_SolverErr);
-   }
-   else
+TERMINATE:
+   for( j = 0; jobs != NULL && j < njobs; ++j )
    {
-      /* unexpected status code
-       * we didn't check for "satisfiable" above, but this is for SAT only
-       */
-      gevLogStat(gev, "Unexpected status code.");
-      gmoModelStatSet(gmo, gmoModelStat_ErrorNoSolution);
-      gmoSolveStatSet(gmo, gmoSolveStat_SystemErr);
+      if( jobs[j].jobid != NULL && optGetIntStr(se->opt, "deletejob") )
+         deletejob(se, jobs[j].jobid);
+      freejob(&jobs[j]);
    }
+   for( j = 0; problems != NULL && j < njobs; ++j )
+      exitbuffer(&problems[j]);
 
-TERMINATE :
-   if( root != NULL )
-      cJSON_Delete(root);
+   free(problems);
+   free(jobs);
+   scenarioFree(&set);
 }
 
-/* stop a started job */
+/** gives the solver options of base with those of settings added, replacing options of the same name */
 static
-void stopjob(
-   gamsse_t* se
-   )
+RETURN mergesolveroptions(
+   const char* base,          /**< JSON object of solver options */
+   const char* settings,      /**< JSON object of solver options to add */
+   char**      json           /**< to store JSON object, must be freed by caller */
+)
 {
-   gevHandle_t gev = se->gev;
-   char strbuffer[1024];
+   cJSON* options;
+   cJSON* added;
+   cJSON* item;
+   RETURN rc = RETURN_ERROR;
 
-   /* gevLog(gev, "Stop job"); */
+   *json = NULL;
 
-   if( resetCurl(se) != RETURN_OK )
+   options = cJSON_Parse(base);
+   added = cJSON_Parse(settings);
+   if( options == NULL || added == NULL )
       goto TERMINATE;
 
-   assert(se->jobid != NULL);
-   sprintf(strbuffer, "https://solve.satalia.com/api/v2/jobs/%s/stop", se->jobid);
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, strbuffer) );
-
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_CUSTOMREQUEST, "DELETE") );
+   while( added->child != NULL )
+   {
+      item = cJSON_DetachItemViaPointer(added, added->child);
+      cJSON_DeleteItemFromObjectCaseSensitive(options, item->string);
+      cJSON_AddItemToObject(options, item->string, item);
+   }
 
-   /* perform HTTP request */
-   if( performCurl(se, NULL) != RETURN_OK )
+   *json = cJSON_PrintUnformatted(options);
+   if( *json == NULL )
       goto TERMINATE;
 
-   if( se->curlwritebuf.length > 2 )
-   {
-      /* something else went wrong */
-      gevLogStatPChar(gev, "stopjob: Failure stopping job: ");
-      gevLogStatPChar(gev, (char*)se->curlwritebuf.content);
-      gevLogStatPChar(gev, "\n");
-   }
+   rc = RETURN_OK;
 
-TERMINATE : ;
+TERMINATE :
+   cJSON_Delete(options);
+   cJSON_Delete(added);
+
+   return rc;
 }
 
-/* stop a started job, doesn't seem to delete the job */
+/** parses a semicolon-separated list of settings of jobs that race on the same problem
+ *
+ * Each setting is a comma-separated list of name=value pairs as for parsesolveroptions(),
+ * which are added to the solver options of all jobs.
+ */
 static
-void deletejob(
-   gamsse_t* se
-   )
+RETURN parseracesettings(
+   gamsse_t*   se,
+   const char* list
+)
 {
-   gevHandle_t gev = se->gev;
-   char strbuffer[1024];
+   char setting[GMS_SSSIZE];
+   char* settingjson;
+   const char* end;
+   int n;
 
-   /* gevLog(gev, "Deleting job"); */
+   assert(se->solveroptions != NULL);
 
-   if( resetCurl(se) != RETURN_OK )
-      goto TERMINATE;
+   /* allocate for the number of semicolons + 1, empty settings are skipped */
+   n = 1;
+   for( end = list; *end != '\0'; ++end )
+      if( *end == ';' )
+         ++n;
 
-   assert(se->jobid != NULL);
-   sprintf(strbuffer, "https://solve.satalia.com/api/v2/jobs/%s", se->jobid);
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_URL, strbuffer) );
+   se->raceoptions = (char**) calloc(n, sizeof(char*));
+   if( se->raceoptions == NULL )
+      return RETURN_ERROR;
 
-   CURL_CHECK( se, curl_easy_setopt(se->curl, CURLOPT_CUSTOMREQUEST, "DELETE") );
+   while( *list != '\0' )
+   {
+      end = list;
+      while( *end != '\0' && *end != ';' )
+         ++end;
 
-   /* perform HTTP request */
-   if( performCurl(se, NULL) != RETURN_OK )
-      goto TERMINATE;
+      if( (size_t)(end - list) >= sizeof(setting) )
+         return RETURN_ERROR;
+      memcpy(setting, list, end - list);
+      setting[end - list] = '\0';
+      list = *end == ';' ? end + 1 : end;
 
-   if( se->curlwritebuf.length > 2 )
-   {
-      /* something else went wrong */
-      gevLogStatPChar(gev, "deletejob: Failure deleting job: ");
-      gevLogStatPChar(gev, (char*)se->curlwritebuf.content);
-      gevLogStatPChar(gev, "\n");
+      if( strspn(setting, " ") == strlen(setting) )
+         continue;
+
+      if( parsesolveroptions(se->gev, setting, &settingjson) != RETURN_OK )
+         return RETURN_ERROR;
+
+      if( mergesolveroptions(se->solveroptions, settingjson, &se->raceoptions[se->nraceoptions]) != RETURN_OK )
+      {
+         free(settingjson);
+         return RETURN_ERROR;
+      }
+      free(settingjson);
+      ++se->nraceoptions;
    }
 
-TERMINATE : ;
+   return RETURN_OK;
 }
 
 static
@@ -1046,9 +4639,58 @@ int dooptions(
          optSetStrStr(opt, "apikey", apikey);
    }
 
+   optGetStrStr(opt, "apiurl", se->apiurl);
+   i = (int)strlen(se->apiurl);
+   while( i > 0 && se->apiurl[i-1] == '/' )
+      se->apiurl[--i] = '\0';
+   se->apiextensions = optGetIntStr(opt, "apiextensions");
+
    se->debug = optGetIntStr(opt, "debug");
    se->verifycert = optGetIntStr(opt, "verifycert");
    se->hardtimelimit = optGetDblStr(opt, "hardtimelimit");
+   se->maxretries = optGetIntStr(opt, "maxretries");
+   se->streamresults = optGetIntStr(opt, "streamresults");
+   se->compression = optGetIntStr(opt, "compression");
+   se->indexthreshold = (size_t)(optGetDblStr(opt, "indexthreshold") * 1024 * 1024);
+   se->indexthreads = optGetIntStr(opt, "indexthreads");
+   se->checksolution = optGetIntStr(opt, "checksolution");
+   se->checktol = optGetDblStr(opt, "checktol");
+   se->checkthreads = optGetIntStr(opt, "checkthreads");
+   se->uploadchunksize = (size_t)(optGetDblStr(opt, "uploadchunksize") * 1024 * 1024);
+   se->uploadconnections = optGetIntStr(opt, "uploadconnections");
+
+   if( se->uploadchunksize > 0 && !se->apiextensions )
+   {
+      gevLog(gev, "SolveEngine does not implement resumable uploads, ignoring option uploadchunksize.");
+      se->uploadchunksize = 0;
+   }
+
+   se->retrydelay = optGetDblStr(opt, "retrydelay");
+   se->retrymaxdelay = optGetDblStr(opt, "retrymaxdelay");
+   se->stopgap = optGetDblStr(opt, "stopgap");
+   se->stopnoimprove = optGetDblStr(opt, "stopnoimprove");
+
+   optGetStrStr(opt, "cachedir", buffer);
+   if( *buffer != '\0' && resultcacheCreate(&se->cache, buffer, optGetDblStr(opt, "cachemaxsize") * 1024 * 1024) != RETURN_OK )
+   {
+      gevLogStatPChar(gev, "Could not open result cache directory ");
+      gevLogStat(gev, buffer);
+      return 1;
+   }
+
+   optGetStrStr(opt, "solveroptions", buffer);
+   if( parsesolveroptions(gev, buffer, &se->solveroptions) != RETURN_OK )
+   {
+      gevLogStat(gev, "Error in option solveroptions.");
+      return 1;
+   }
+
+   optGetStrStr(opt, "racesettings", buffer);
+   if( parseracesettings(se, buffer) != RETURN_OK )
+   {
+      gevLogStat(gev, "Error in option racesettings.");
+      return 1;
+   }
 
    return 0;
 }
@@ -1078,9 +4720,13 @@ int se_CallSolver(
 )
 {
    char buffer[1024];
-   char* status = NULL;
-   double res;
+   char deltadir[GMS_SSSIZE];
+   buffer_t problem = BUFFERINIT;
+   modeldelta_t* deltabase = NULL;
+   sejob_t job;
    palHandle_t pal;
+   int local = 0;
+   int i;
 
    if( !gmoGetReady(buffer, sizeof(buffer)) )
    {
@@ -1095,6 +4741,7 @@ int se_CallSolver(
    }
 
    memset(se, 0, sizeof(gamsse_t));
+   memset(&job, 0, sizeof(sejob_t));
    se->gmo = gmo;
    se->gev = gmoEnvironment(gmo);
 
@@ -1123,6 +4770,12 @@ int se_CallSolver(
    if( dooptions(se) )
       goto TERMINATE;
 
+   /* small models are solved by the local solver, so there is no need to contact SolveEngine, except for the job list;
+    * scenarios are always submitted to SolveEngine
+    */
+   optGetStrStr(se->opt, "scenariofile", buffer);
+   local = *buffer == '\0' && uselocalsolver(se);
+
    if( gmoGetVarTypeCnt(gmo, gmovar_SI) )
    {
       gevLogStat(se->gev, "Semi-integer variables not supported.\n");
@@ -1131,23 +4784,35 @@ int se_CallSolver(
       goto TERMINATE;
    }
 
-   optGetStrStr(se->opt, "apikey", buffer);
-   if( *buffer == '\0' )
-   {
-      gevLogStat(se->gev, "No SolveEngine API key found in options file (option 'apikey') or environment (SOLVEENGINE_APIKEY). Exiting.");
-      gmoModelStatSet(se->gmo, gmoModelStat_ErrorNoSolution);
-      gmoSolveStatSet(se->gmo, gmoSolveStat_License);
-      goto TERMINATE;
-   }
-   if( strlen(buffer) > 50 ) /* mine is 45 chars */
+   if( !local || optGetIntStr(se->opt, "printjoblist") )
    {
-      gevLogStat(se->gev, "Invalid API key: too long. Exiting.");
-      goto TERMINATE;
+      optGetStrStr(se->opt, "apikey", buffer);
+      if( *buffer == '\0' )
+      {
+         gevLogStat(se->gev, "No SolveEngine API key found in options file (option 'apikey') or environment (SOLVEENGINE_APIKEY). Exiting.");
+         gmoModelStatSet(se->gmo, gmoModelStat_ErrorNoSolution);
+         gmoSolveStatSet(se->gmo, gmoSolveStat_License);
+         goto TERMINATE;
+      }
+      if( strlen(buffer) > 50 ) /* mine is 45 chars */
+      {
+         gevLogStat(se->gev, "Invalid API key: too long. Exiting.");
+         goto TERMINATE;
+      }
+      se->apikey = strdup(buffer);
+
+      if( metricsCreate(&se->metrics) != RETURN_OK )
+         goto TERMINATE;
+
+      if( initCurl(se) != RETURN_OK )
+         goto TERMINATE;
    }
-   se->apikey = strdup(buffer);
 
-   if( initCurl(se) != RETURN_OK )
-      goto TERMINATE;
+   /* open connection to SolveEngine while we print the job list and convert the problem,
+    * but not if the results may come from the cache, which should not contact SolveEngine, or if the model is solved locally
+    */
+   if( optGetIntStr(se->opt, "prewarm") && se->cache == NULL && !local )
+      startprewarm(se);
 
    if( optGetIntStr(se->opt, "printjoblist") )
       printjoblist(se);
@@ -1158,72 +4823,139 @@ int se_CallSolver(
    gmoIndexBaseSet(se->gmo, 0);
    gmoSetNRowPerm(se->gmo); /* hide =N= rows */
 
-   if( submitjob(se) != RETURN_OK )
+   optGetStrStr(se->opt, "scenariofile", buffer);
+   if( *buffer != '\0' && !se->apiextensions )
+   {
+      gevLog(se->gev, "SolveEngine does not implement problems that refer to earlier ones, ignoring option scenariofile.");
+      *buffer = '\0';
+   }
+   if( *buffer != '\0' )
+   {
+      solvescenarios(se, buffer);
       goto TERMINATE;
+   }
 
-   if( schedulejob(se) != RETURN_OK )
-      goto TERMINATE;
+   optGetStrStr(se->opt, "deltadir", deltadir);
+   if( *deltadir != '\0' && !se->apiextensions )
+   {
+      gevLog(se->gev, "SolveEngine does not implement problems that refer to earlier ones, ignoring option deltadir.");
+      *deltadir = '\0';
+   }
+   if( *deltadir != '\0' && !local )
+      preparedelta(se, deltadir, &deltabase);
 
-   gevTimeSetStart(se->gev);
+   if( optGetIntStr(se->opt, "presolve") )
+      presolveproblem(se);
 
-   do
+   if( local )
    {
-      sleep(1);
-      res = gevTimeDiffStart(se->gev);
+      sprintf(buffer, "Model has %d nonzeros, solving it with the local solver.", gmoNZ(se->gmo));
+      gevLog(se->gev, buffer);
+      solvelocal(se);
+      goto TERMINATE;
+   }
 
-      free(status);
-      status = jobstatus(se);
-      sprintf(buffer, "%8.1fs Job Status: %s\n", res, status != NULL ? status : "UNKNOWN");
-      gevLogPChar(se->gev, buffer);
+   if( optGetIntStr(se->opt, "decompose") > 1 )
+      decomposeproblem(se, optGetIntStr(se->opt, "decompose"));
 
-      if( gevTerminateGet(se->gev) )
-      {
-         gevLog(se->gev, "User Interrupt.\n");
-         gmoModelStatSet(se->gmo, gmoModelStat_NoSolutionReturned);
-         gmoSolveStatSet(se->gmo, gmoSolveStat_User);
-         break;
-      }
+   if( se->decomp != NULL )
+   {
+      solveblocks(se);
+      goto TERMINATE;
+   }
 
-      if( res > se->hardtimelimit )
+   if( se->nraceoptions > 0 )
+   {
+      if( se->modeldelta != NULL )
+         gevLog(se->gev, "Racing is not applied when sending changes of models.");
+      else if( se->cache != NULL )
+         gevLog(se->gev, "Racing is not applied when results are cached.");
+      else
       {
-         gevLog(se->gev, "Hard time limit reached.\n");
-         gmoModelStatSet(se->gmo, gmoModelStat_NoSolutionReturned);
-         gmoSolveStatSet(se->gmo, gmoSolveStat_Resource);
-         break;
+         solverace(se);
+         goto TERMINATE;
       }
    }
-   while( status != NULL && (
-     strcmp(status, "created") == 0 ||  /* we should not get status "created" after having submitted the job, but it seems to happen anyway; hopefully we just have to wait a bit */
-     strcmp(status, "queued") == 0 ||   /* if queued, then we wait for available resources - hope that this wouldn't take too long */
-     strcmp(status, "translating") == 0 ||
-     strcmp(status, "started") == 0 ||
-     strcmp(status, "starting") == 0) );
 
-   gmoSetHeadnTail(se->gmo, gmoHresused, gevTimeDiffStart(se->gev));
+   if( buildproblem(se, &problem, deltabase, -1, se->modeldelta != NULL ? se->modeldelta->problemkey : NULL) != RETURN_OK )
+      goto TERMINATE;
 
-   /* if job has been completed, then get results */
-   if( status != NULL && strcmp(status, "completed") == 0 )
-      getsolution(se);
+   if( se->cache != NULL && getcachedsolution(se) )
+      goto TERMINATE;
 
-   /* if job has reached timeout, then set status accordingly */
-   if( status != NULL && (strcmp(status, "timeout") == 0 ) )
+   finishprewarm(se);
+
+   if( initjob(se, &job, NULL, &problem) != RETURN_OK )
+      goto TERMINATE;
+
+   if( runjobs(se, &job, 1, 0) != RETURN_OK )
+      goto TERMINATE;
+
+   /* SolveEngine may not have the earlier problem anymore, so try again with the complete problem */
+   if( deltabase != NULL && job.jobid == NULL && !gevTerminateGet(se->gev) )
    {
-      /* cannot get any solution in this case... */
-      gmoModelStatSet(se->gmo, gmoModelStat_NoSolutionReturned);
-      gmoSolveStatSet(se->gmo, gmoSolveStat_Resource);
+      gevLog(se->gev, "Submitting changes failed, submitting complete problem.");
+      modeldeltaFree(&deltabase);
+      freejob(&job);
+      exitbuffer(&problem);
+
+      if( buildproblem(se, &problem, NULL, -1, se->modeldelta->problemkey) != RETURN_OK )
+         goto TERMINATE;
+
+      if( initjob(se, &job, NULL, &problem) != RETURN_OK )
+         goto TERMINATE;
+
+      if( runjobs(se, &job, 1, 0) != RETURN_OK )
+         goto TERMINATE;
    }
 
-   /* if job has been interrupted (Ctrl+C), then stop it */
-   if( status != NULL && (strcmp(status, "started") == 0 || strcmp(status, "starting") == 0) )
-      stopjob(se);
+   /* SolveEngine keeps the problem of a submitted job, so the next solve can send changes against it */
+   if( se->modeldelta != NULL && job.jobid != NULL && modeldeltaSave(se->modeldelta, deltadir) != RETURN_OK )
+   {
+      gevLogPChar(se->gev, "Could not store vectors of model in directory ");
+      gevLog(se->gev, deltadir);
+   }
+
+   gmoSetHeadnTail(se->gmo, gmoHresused, gevTimeDiffStart(se->gev) - job.starttime);
+
+   /* if job has been completed, then get results */
+   if( job.results != NULL || job.resultsread )
+      getsolution(se, &job);
+
+   /* only results of jobs that finished on their own are reused */
+   if( se->cache != NULL && (job.results != NULL || job.resultsread) && job.stop == JOBSTOP_NONE && gmoSolveStat(se->gmo) == gmoSolveStat_Normal )
+      storecachedsolution(se, &job);
 
-   /* if job has failed, then return solver error (instead of system error) */
-   if( status != NULL && strcmp(status, "failed") == 0 )
-      gmoSolveStatSet(se->gmo, gmoSolveStat_SolverErr);
+   finishjob(se, &job);
 
 TERMINATE:
-   if( se->jobid != NULL && optGetIntStr(se->opt, "deletejob") )
-      deletejob(se);
+   if( job.jobid != NULL && optGetIntStr(se->opt, "deletejob") )
+      deletejob(se, job.jobid);
+
+   finishprewarm(se);
+
+   freejob(&job);
+   exitbuffer(&problem);
+   modeldeltaFree(&deltabase);
+   modeldeltaFree(&se->modeldelta);
+   decompFree(&se->decomp);
+   presolveFree(&se->presolve);
+   modelsnapFree(&se->modelsnap);
+   resultcacheFree(&se->cache);
+
+   if( se->metrics != NULL )
+   {
+      metricsReport(se->metrics, se->gev);
+
+      optGetStrStr(se->opt, "metricsfile", buffer);
+      if( *buffer != '\0' && metricsWriteJSON(se->metrics, buffer) != RETURN_OK )
+      {
+         gevLogStatPChar(se->gev, "Error writing metrics file ");
+         gevLogStat(se->gev, buffer);
+      }
+
+      metricsFree(&se->metrics);
+   }
 
    if( se->opt != NULL )
       optFree(&se->opt);
@@ -1234,11 +4966,22 @@ TERMINATE:
    if( se->curl != NULL )
       curl_easy_cleanup(se->curl);
 
+   if( se->curlshare != NULL )
+   {
+      curl_share_cleanup(se->curlshare);
+#ifndef _WIN32
+      for( i = 0; i < CURL_LOCK_DATA_LAST; ++i )
+         pthread_mutex_destroy(&se->curlsharelocks[i]);
+#endif
+   }
+
    exitbuffer(&se->curlwritebuf);
 
-   free(se->jobid);
    free(se->apikey);
-   free(status);
+   free(se->solveroptions);
+   for( i = 0; i < se->nraceoptions; ++i )
+      free(se->raceoptions[i]);
+   free(se->raceoptions);
 
    return 0;
 }
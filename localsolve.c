@@ -0,0 +1,306 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#ifndef _WIN32
+#include <strings.h>  /* for strncasecmp() */
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include "localsolve.h"
+
+#ifdef _WIN32
+#define strncasecmp _strnicmp
+#endif
+
+struct localsolve_s
+{
+#ifndef _WIN32
+   pid_t       pid;          /**< process of solver, which leads its process group, or 0 if it has finished */
+#endif
+   int         exitcode;     /**< exit code of solver once it has finished, or -1 if it did not exit normally */
+};
+
+/** appends a string to a command, in single quotes so that the shell takes it as one word */
+static
+char* appendquoted(
+   char*       cmd,
+   const char* str
+)
+{
+   *cmd++ = '\'';
+   for( ; *str != '\0'; ++str )
+   {
+      if( *str == '\'' )
+      {
+         /* end quote, escaped quote, and start quote again */
+         memcpy(cmd, "'\\''", 4);
+         cmd += 4;
+      }
+      else
+         *cmd++ = *str;
+   }
+   *cmd++ = '\'';
+
+   return cmd;
+}
+
+RETURN localsolveStart(
+   localsolve_t** ls,
+   const char*    command,
+   const char*    lpfile,
+   const char*    solfile,
+   int            showoutput
+)
+{
+#ifdef _WIN32
+   assert(ls != NULL);
+
+   *ls = NULL;
+
+   return RETURN_ERROR;
+#else
+   char* cmd;
+   char* end;
+   size_t length;
+   pid_t pid;
+
+   assert(ls != NULL);
+   assert(command != NULL);
+   assert(lpfile != NULL);
+   assert(solfile != NULL);
+
+   *ls = NULL;
+
+   /* each replaced name may take up to four times its length when quotes are escaped, plus the surrounding quotes */
+   length = strlen(command) + 1;
+   for( end = strchr(command, '%'); end != NULL; end = strchr(end + 1, '%') )
+      length += 4 * (strlen(lpfile) + strlen(solfile)) + 2;
+
+   cmd = (char*) malloc(length);
+   if( cmd == NULL )
+      return RETURN_ERROR;
+
+   end = cmd;
+   while( *command != '\0' )
+   {
+      if( strncmp(command, "%lp", 3) == 0 )
+      {
+         end = appendquoted(end, lpfile);
+         command += 3;
+      }
+      else if( strncmp(command, "%sol", 4) == 0 )
+      {
+         end = appendquoted(end, solfile);
+         command += 4;
+      }
+      else
+         *end++ = *command++;
+   }
+   *end = '\0';
+
+   *ls = (localsolve_t*) calloc(1, sizeof(localsolve_t));
+   if( *ls == NULL )
+   {
+      free(cmd);
+      return RETURN_ERROR;
+   }
+
+   pid = fork();
+   if( pid == 0 )
+   {
+      /* the shell may run the solver as a child, so put both into a process group of their own that can be signalled as a whole */
+      setpgid(0, 0);
+
+      if( !showoutput )
+      {
+         int devnull = open("/dev/null", O_WRONLY);
+         if( devnull >= 0 )
+         {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+            close(devnull);
+         }
+      }
+      execl("/bin/sh", "sh", "-c", cmd, (char*)NULL);
+      _exit(127);
+   }
+
+   free(cmd);
+
+   if( pid < 0 )
+   {
+      localsolveFree(ls);
+      return RETURN_ERROR;
+   }
+
+   (*ls)->pid = pid;
+
+   return RETURN_OK;
+#endif
+}
+
+void localsolveFree(
+   localsolve_t** ls
+)
+{
+   assert(ls != NULL);
+
+   if( *ls == NULL )
+      return;
+
+#ifndef _WIN32
+   if( (*ls)->pid > 0 )
+   {
+      kill(-(*ls)->pid, SIGKILL);
+      waitpid((*ls)->pid, NULL, 0);
+   }
+#endif
+
+   free(*ls);
+   *ls = NULL;
+}
+
+int localsolveIsRunning(
+   localsolve_t* ls,
+   int*          exitcode
+)
+{
+   assert(ls != NULL);
+   assert(exitcode != NULL);
+
+#ifndef _WIN32
+   if( ls->pid > 0 )
+   {
+      int status;
+      pid_t pid;
+
+      pid = waitpid(ls->pid, &status, WNOHANG);
+      if( pid == 0 )
+         return 1;
+
+      ls->exitcode = (pid == ls->pid && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+      ls->pid = 0;
+   }
+#endif
+
+   *exitcode = ls->exitcode;
+
+   return 0;
+}
+
+void localsolveStop(
+   localsolve_t* ls
+)
+{
+   assert(ls != NULL);
+
+#ifndef _WIN32
+   if( ls->pid > 0 )
+      kill(-ls->pid, SIGTERM);
+#endif
+}
+
+/** maps the status line of a CBC solution file to a status of SolveEngine */
+static
+const char* parsestatus(
+   const char* line
+)
+{
+   if( strncasecmp(line, "Optimal", 7) == 0 )
+      return "optimal";
+   if( strstr(line, "nfeasible") != NULL )
+      return "infeasible";
+   if( strncasecmp(line, "Unbounded", 9) == 0 )
+      return "unbounded";
+   if( strncasecmp(line, "Stopped", 7) == 0 )
+      return "timeout";
+   return "error";
+}
+
+RETURN localsolveReadSolution(
+   const char* solfile,
+   cJSON**     results
+)
+{
+   FILE* f;
+   char line[1024];
+   cJSON* result;
+   cJSON* variables;
+   const char* objval;
+   const char* status;
+   RETURN rc = RETURN_ERROR;
+
+   assert(solfile != NULL);
+   assert(results != NULL);
+
+   *results = NULL;
+
+   f = fopen(solfile, "r");
+   if( f == NULL )
+      return RETURN_ERROR;
+
+   if( fgets(line, sizeof(line), f) == NULL )
+      goto TERMINATE;
+
+   status = parsestatus(line);
+
+   *results = cJSON_CreateObject();
+   result = cJSON_AddObjectToObject(*results, "result");
+   if( result == NULL || cJSON_AddStringToObject(result, "status", status) == NULL )
+      goto TERMINATE;
+
+   objval = strstr(line, "objective value");
+   if( objval != NULL && cJSON_AddNumberToObject(result, "objective_value", atof(objval + 15)) == NULL )
+      goto TERMINATE;
+
+   /* the values of an infeasible or unbounded model are no solution */
+   if( strcmp(status, "optimal") != 0 && strcmp(status, "timeout") != 0 )
+   {
+      rc = RETURN_OK;
+      goto TERMINATE;
+   }
+
+   variables = cJSON_AddArrayToObject(result, "variables");
+   if( variables == NULL )
+      goto TERMINATE;
+
+   while( fgets(line, sizeof(line), f) != NULL )
+   {
+      char name[256];
+      double value;
+      char* p = line;
+      cJSON* var;
+
+      /* CBC marks values that violate bounds with ** */
+      while( *p == ' ' || *p == '*' )
+         ++p;
+
+      if( sscanf(p, "%*d %255s %lf", name, &value) != 2 || convertParseVarIdx(name) < 0 )
+         continue;
+
+      var = cJSON_CreateObject();
+      if( var == NULL )
+         goto TERMINATE;
+      cJSON_AddItemToArray(variables, var);
+      if( cJSON_AddStringToObject(var, "name", name) == NULL || cJSON_AddNumberToObject(var, "value", value) == NULL )
+         goto TERMINATE;
+   }
+
+   rc = RETURN_OK;
+
+TERMINATE:
+   fclose(f);
+
+   if( rc != RETURN_OK )
+   {
+      cJSON_Delete(*results);
+      *results = NULL;
+   }
+
+   return rc;
+}
@@ -0,0 +1,57 @@
+#ifndef LOCALSOLVE_H_
+#define LOCALSOLVE_H_
+
+#include "cJSON.h"
+
+#include "convert.h"  /* for RETURN */
+
+/** a command-line solver that runs in a process of its own on an .lp file and writes a solution file */
+typedef struct localsolve_s localsolve_t;
+
+/** starts a solver command
+ *
+ * In the command, %lp and %sol are replaced by the quoted names of the .lp file and the solution file.
+ * The command is run by the shell, with its output discarded unless showoutput is set.
+ */
+extern
+RETURN localsolveStart(
+   localsolve_t** ls,
+   const char*    command,
+   const char*    lpfile,
+   const char*    solfile,
+   int            showoutput
+);
+
+/** frees a solver, and terminates it if it is still running */
+extern
+void localsolveFree(
+   localsolve_t** ls
+);
+
+/** gives whether the solver is still running, and otherwise stores its exit code, which is -1 if it did not exit normally */
+extern
+int localsolveIsRunning(
+   localsolve_t* ls,
+   int*          exitcode
+);
+
+/** asks a running solver to terminate */
+extern
+void localsolveStop(
+   localsolve_t* ls
+);
+
+/** reads a solution file in the format of CBC into results of the form that SolveEngine gives
+ *
+ * The first line has the status and objective value, e.g., "Optimal - objective value 42",
+ * and each further line has the number, name, value, and reduced cost of a variable.
+ * Only variables with nonzero value need to be listed, and they are only read if the status is optimal or stopped.
+ * Variables whose names are not of the form given by convertGetVarName(), e.g., objconstant, are left out.
+ */
+extern
+RETURN localsolveReadSolution(
+   const char* solfile,
+   cJSON**     results       /**< to store results, must be freed by caller */
+);
+
+#endif /* LOCALSOLVE_H_ */
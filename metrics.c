@@ -0,0 +1,373 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "metrics.h"
+#include "cJSON.h"
+
+#include "gevmcc.h"
+
+struct metrics_s
+{
+   metricsreq_t* reqs;
+   int           nreqs;
+   int           reqssize;
+};
+
+/** totals of requests of one kind */
+typedef struct
+{
+   const char* request;
+   const char* jobid;
+   int         count;
+   int         failed;           /**< number of requests with transfer error or HTTP error response */
+   int         retries;          /**< number of requests that repeated a failed request */
+   double      dns;              /**< time for name resolving */
+   double      tcp;              /**< time for TCP connect */
+   double      tls;              /**< time for TLS handshake */
+   double      wait;             /**< time from sending request until first byte of response, includes upload */
+   double      receive;          /**< time from first until last byte of response */
+   double      total;
+   curl_off_t  uploaded;
+   curl_off_t  downloaded;
+   curl_off_t  decoded;
+} metricstotal_t;
+
+RETURN metricsCreate(
+   metrics_t** metrics
+)
+{
+   assert(metrics != NULL);
+
+   *metrics = (metrics_t*) calloc(1, sizeof(metrics_t));
+
+   return *metrics != NULL ? RETURN_OK : RETURN_ERROR;
+}
+
+void metricsFree(
+   metrics_t** metrics
+)
+{
+   assert(metrics != NULL);
+
+   if( *metrics == NULL )
+      return;
+
+   free((*metrics)->reqs);
+   free(*metrics);
+   *metrics = NULL;
+}
+
+/** gets a time from curl in seconds */
+static
+double gettime(
+   CURL*    curl,
+   CURLINFO info
+)
+{
+   curl_off_t t = 0;
+
+   if( curl_easy_getinfo(curl, info, &t) != CURLE_OK )
+      return 0.0;
+
+   return t / 1e6;
+}
+
+RETURN metricsAddRequest(
+   metrics_t*  metrics,
+   CURL*       curl,
+   const char* request,
+   const char* jobid,
+   int         retry,
+   CURLcode    result,
+   curl_off_t  decoded
+)
+{
+   metricsreq_t* req;
+
+   assert(metrics != NULL);
+   assert(curl != NULL);
+   assert(request != NULL);
+
+   if( metrics->nreqs == metrics->reqssize )
+   {
+      metricsreq_t* newreqs;
+      int newsize;
+
+      newsize = 2 * metrics->reqssize + 16;
+      newreqs = (metricsreq_t*) realloc(metrics->reqs, newsize * sizeof(metricsreq_t));
+      if( newreqs == NULL )
+         return RETURN_ERROR;
+
+      metrics->reqs = newreqs;
+      metrics->reqssize = newsize;
+   }
+
+   req = &metrics->reqs[metrics->nreqs++];
+   memset(req, 0, sizeof(metricsreq_t));
+
+   req->request = request;
+   if( jobid != NULL )
+   {
+      strncpy(req->jobid, jobid, sizeof(req->jobid)-1);
+      req->jobid[sizeof(req->jobid)-1] = '\0';
+   }
+   req->retry = retry;
+   req->result = result;
+   req->decoded = decoded;
+   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &req->respcode);
+
+   req->namelookup = gettime(curl, CURLINFO_NAMELOOKUP_TIME_T);
+   req->connect = gettime(curl, CURLINFO_CONNECT_TIME_T);
+   req->appconnect = gettime(curl, CURLINFO_APPCONNECT_TIME_T);
+   req->pretransfer = gettime(curl, CURLINFO_PRETRANSFER_TIME_T);
+   req->starttransfer = gettime(curl, CURLINFO_STARTTRANSFER_TIME_T);
+   req->total = gettime(curl, CURLINFO_TOTAL_TIME_T);
+
+   curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &req->uploaded);
+   curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &req->downloaded);
+   curl_easy_getinfo(curl, CURLINFO_SPEED_UPLOAD_T, &req->uploadspeed);
+   curl_easy_getinfo(curl, CURLINFO_SPEED_DOWNLOAD_T, &req->downloadspeed);
+
+   return RETURN_OK;
+}
+
+/** adds a request to totals */
+static
+void addtotal(
+   metricstotal_t*     total,
+   const metricsreq_t* req
+)
+{
+   ++total->count;
+   if( req->result != CURLE_OK || req->respcode >= 400 )
+      ++total->failed;
+   if( req->retry > 0 )
+      ++total->retries;
+
+   /* the CURLINFO times are accumulating, so take differences to get the time for each stage
+    * stages that did not happen (e.g., connect if connection has been reused) report 0
+    */
+   total->dns += req->namelookup;
+   if( req->connect > 0.0 )
+      total->tcp += req->connect - req->namelookup;
+   if( req->appconnect > 0.0 )
+      total->tls += req->appconnect - req->connect;
+   if( req->starttransfer > 0.0 )
+   {
+      total->wait += req->starttransfer - req->pretransfer;
+      total->receive += req->total - req->starttransfer;
+   }
+   total->total += req->total;
+   total->uploaded += req->uploaded;
+   total->downloaded += req->downloaded;
+   total->decoded += req->decoded;
+}
+
+/** computes totals for each pair of job and kind of request
+ *
+ * @return number of totals, or -1 if out of memory
+ */
+static
+int computetotals(
+   metrics_t*       metrics,
+   metricstotal_t** totals
+)
+{
+   int ntotals = 0;
+   int i;
+   int t;
+
+   *totals = (metricstotal_t*) calloc(metrics->nreqs + 1, sizeof(metricstotal_t));
+   if( *totals == NULL )
+      return -1;
+
+   for( i = 0; i < metrics->nreqs; ++i )
+   {
+      metricsreq_t* req = &metrics->reqs[i];
+
+      for( t = 0; t < ntotals; ++t )
+         if( strcmp((*totals)[t].request, req->request) == 0 && strcmp((*totals)[t].jobid, req->jobid) == 0 )
+            break;
+
+      if( t == ntotals )
+      {
+         (*totals)[t].request = req->request;
+         (*totals)[t].jobid = req->jobid;
+         ++ntotals;
+      }
+
+      addtotal(&(*totals)[t], req);
+   }
+
+   return ntotals;
+}
+
+void metricsReport(
+   metrics_t*     metrics,
+   struct gevRec* gev
+)
+{
+   metricstotal_t* totals;
+   char buffer[GMS_SSSIZE];
+   int ntotals;
+   int t;
+   int s;
+
+   assert(metrics != NULL);
+
+   if( metrics->nreqs == 0 )
+      return;
+
+   ntotals = computetotals(metrics, &totals);
+   if( ntotals < 0 )
+      return;
+
+   for( t = 0; t < ntotals; ++t )
+   {
+      /* handle each job once, when seeing it the first time */
+      for( s = 0; s < t; ++s )
+         if( strcmp(totals[s].jobid, totals[t].jobid) == 0 )
+            break;
+      if( s < t )
+         continue;
+
+      if( *totals[t].jobid != '\0' )
+         sprintf(buffer, "\nHTTP timing report for job %s (times in seconds):\n", totals[t].jobid);
+      else
+         sprintf(buffer, "\nHTTP timing report for requests without job (times in seconds):\n");
+      gevLogPChar(gev, buffer);
+      sprintf(buffer, "%-10s %5s %8s %8s %8s %8s %8s %8s %12s %12s %12s %10s\n",
+         "Request", "Count", "DNS", "Connect", "TLS", "Wait", "Receive", "Total", "Uploaded", "Downloaded", "Decoded", "KB/s");
+      gevLogPChar(gev, buffer);
+
+      for( s = t; s < ntotals; ++s )
+      {
+         metricstotal_t* total = &totals[s];
+
+         if( strcmp(total->jobid, totals[t].jobid) != 0 )
+            continue;
+
+         sprintf(buffer, "%-10s %5d %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %12" CURL_FORMAT_CURL_OFF_T " %12" CURL_FORMAT_CURL_OFF_T " %12" CURL_FORMAT_CURL_OFF_T " %10.1f\n",
+            total->request, total->count, total->dns, total->tcp, total->tls, total->wait, total->receive, total->total,
+            total->uploaded, total->downloaded, total->decoded,
+            total->total > 0.0 ? (total->uploaded + total->downloaded) / total->total / 1024.0 : 0.0);
+         gevLogPChar(gev, buffer);
+
+         if( total->failed > 0 )
+         {
+            sprintf(buffer, "%-10s %5d failed\n", "", total->failed);
+            gevLogPChar(gev, buffer);
+         }
+
+         if( total->retries > 0 )
+         {
+            sprintf(buffer, "%-10s %5d retries\n", "", total->retries);
+            gevLogPChar(gev, buffer);
+         }
+      }
+   }
+   gevLogPChar(gev, "\n");
+
+   free(totals);
+}
+
+RETURN metricsWriteJSON(
+   metrics_t*  metrics,
+   const char* filename
+)
+{
+   metricstotal_t* totals = NULL;
+   cJSON* root = NULL;
+   cJSON* arr;
+   cJSON* item;
+   char* str = NULL;
+   FILE* file = NULL;
+   RETURN rc = RETURN_ERROR;
+   int ntotals;
+   int i;
+
+   assert(metrics != NULL);
+   assert(filename != NULL);
+
+   root = cJSON_CreateObject();
+   if( root == NULL )
+      goto TERMINATE;
+
+   arr = cJSON_AddArrayToObject(root, "requests");
+   for( i = 0; i < metrics->nreqs; ++i )
+   {
+      metricsreq_t* req = &metrics->reqs[i];
+
+      item = cJSON_CreateObject();
+      cJSON_AddItemToArray(arr, item);
+
+      cJSON_AddStringToObject(item, "request", req->request);
+      cJSON_AddStringToObject(item, "job", req->jobid);
+      cJSON_AddNumberToObject(item, "retry", req->retry);
+      cJSON_AddNumberToObject(item, "curlcode", req->result);
+      cJSON_AddNumberToObject(item, "responsecode", req->respcode);
+      cJSON_AddNumberToObject(item, "namelookup_time", req->namelookup);
+      cJSON_AddNumberToObject(item, "connect_time", req->connect);
+      cJSON_AddNumberToObject(item, "appconnect_time", req->appconnect);
+      cJSON_AddNumberToObject(item, "pretransfer_time", req->pretransfer);
+      cJSON_AddNumberToObject(item, "starttransfer_time", req->starttransfer);
+      cJSON_AddNumberToObject(item, "total_time", req->total);
+      cJSON_AddNumberToObject(item, "size_upload", (double)req->uploaded);
+      cJSON_AddNumberToObject(item, "size_download", (double)req->downloaded);
+      cJSON_AddNumberToObject(item, "size_decoded", (double)req->decoded);
+      cJSON_AddNumberToObject(item, "speed_upload", (double)req->uploadspeed);
+      cJSON_AddNumberToObject(item, "speed_download", (double)req->downloadspeed);
+   }
+
+   ntotals = computetotals(metrics, &totals);
+   if( ntotals < 0 )
+      goto TERMINATE;
+
+   arr = cJSON_AddArrayToObject(root, "totals");
+   for( i = 0; i < ntotals; ++i )
+   {
+      metricstotal_t* total = &totals[i];
+
+      item = cJSON_CreateObject();
+      cJSON_AddItemToArray(arr, item);
+
+      cJSON_AddStringToObject(item, "request", total->request);
+      cJSON_AddStringToObject(item, "job", total->jobid);
+      cJSON_AddNumberToObject(item, "count", total->count);
+      cJSON_AddNumberToObject(item, "failed", total->failed);
+      cJSON_AddNumberToObject(item, "retries", total->retries);
+      cJSON_AddNumberToObject(item, "dns", total->dns);
+      cJSON_AddNumberToObject(item, "connect", total->tcp);
+      cJSON_AddNumberToObject(item, "tls", total->tls);
+      cJSON_AddNumberToObject(item, "wait", total->wait);
+      cJSON_AddNumberToObject(item, "receive", total->receive);
+      cJSON_AddNumberToObject(item, "total", total->total);
+      cJSON_AddNumberToObject(item, "uploaded", (double)total->uploaded);
+      cJSON_AddNumberToObject(item, "downloaded", (double)total->downloaded);
+      cJSON_AddNumberToObject(item, "decoded", (double)total->decoded);
+   }
+
+   str = cJSON_Print(root);
+   if( str == NULL )
+      goto TERMINATE;
+
+   file = fopen(filename, "w");
+   if( file == NULL )
+      goto TERMINATE;
+
+   if( fputs(str, file) < 0 || fputc('\n', file) == EOF )
+      goto TERMINATE;
+
+   rc = RETURN_OK;
+
+TERMINATE:
+   if( file != NULL && fclose(file) != 0 )
+      rc = RETURN_ERROR;
+   cJSON_free(str);
+   cJSON_Delete(root);
+   free(totals);
+
+   return rc;
+}
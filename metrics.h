@@ -0,0 +1,71 @@
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include "curl/curl.h"
+
+#include "convert.h"  /* for RETURN */
+
+struct gevRec;
+
+/** timing and transfer statistics of a single HTTP request */
+typedef struct
+{
+   const char* request;          /**< kind of request, e.g., "submit" or "status" */
+   char        jobid[64];        /**< job that the request belongs to, or empty */
+   int         retry;            /**< number of retry, 0 for first attempt */
+   CURLcode    result;           /**< result of transfer */
+   long        respcode;         /**< HTTP response code */
+   /* times in seconds since start of request, see CURLINFO_*_TIME_T */
+   double      namelookup;       /**< until name resolving completed */
+   double      connect;          /**< until TCP connection established */
+   double      appconnect;       /**< until TLS handshake completed, 0 if no TLS or connection reused */
+   double      pretransfer;      /**< until transfer is about to begin */
+   double      starttransfer;    /**< until first byte of response has been received */
+   double      total;            /**< until request finished */
+   curl_off_t  uploaded;         /**< number of bytes uploaded */
+   curl_off_t  downloaded;       /**< number of bytes downloaded, possibly compressed */
+   curl_off_t  decoded;          /**< number of bytes of response after decompression */
+   curl_off_t  uploadspeed;      /**< average upload speed in bytes per second */
+   curl_off_t  downloadspeed;    /**< average download speed in bytes per second */
+} metricsreq_t;
+
+/** collection of statistics of all HTTP requests */
+typedef struct metrics_s metrics_t;
+
+extern
+RETURN metricsCreate(
+   metrics_t** metrics
+);
+
+extern
+void metricsFree(
+   metrics_t** metrics
+);
+
+/** records statistics of a finished request */
+extern
+RETURN metricsAddRequest(
+   metrics_t*  metrics,
+   CURL*       curl,
+   const char* request,          /**< kind of request, must be a static string */
+   const char* jobid,            /**< job that the request belongs to, or NULL */
+   int         retry,            /**< number of retry, 0 for first attempt */
+   CURLcode    result,           /**< result of transfer */
+   curl_off_t  decoded           /**< number of bytes of response that have been passed to the write function */
+);
+
+/** prints timing report for each job to the log */
+extern
+void metricsReport(
+   metrics_t*     metrics,
+   struct gevRec* gev
+);
+
+/** writes statistics of all requests and totals per kind of request to a JSON file */
+extern
+RETURN metricsWriteJSON(
+   metrics_t*  metrics,
+   const char* filename
+);
+
+#endif /* METRICS_H_ */
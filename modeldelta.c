@@ -0,0 +1,427 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "modeldelta.h"
+
+#include "gmomcc.h"
+
+#define DELTAFILEHEADER "GAMSSEDELTA1\n"
+
+int modeldeltaIsSupported(
+   const modelsnap_t* snap
+)
+{
+   int j;
+
+   assert(snap != NULL);
+
+   for( j = 0; j < snap->nz; ++j )
+      if( snap->nlflag[j] )
+         return 0;
+
+   /* SOS are written into the problem with their weights, which are not covered by the delta */
+   for( j = 0; j < snap->n; ++j )
+      if( snap->vartype[j] == gmovar_S1 || snap->vartype[j] == gmovar_S2 )
+         return 0;
+
+   return 1;
+}
+
+/** computes the key of the structure and the vectors of a model */
+static
+void computekeys(
+   modeldelta_t*      delta,
+   const modelsnap_t* snap
+)
+{
+   /* room for the key of each part and the dimensions */
+   char keys[9 * RESULTCACHE_KEYLENGTH + 100];
+   size_t len;
+
+   len = sprintf(keys, "%d %d %d %d ", snap->n, snap->m, snap->nz, snap->objsense);
+   resultcacheKey(snap->vartype, snap->n * sizeof(int), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(snap->equtype, snap->m * sizeof(int), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(snap->rowstart, (snap->m + 1) * sizeof(int), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(snap->colidx, snap->nz * sizeof(int), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(snap->val, snap->nz * sizeof(double), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(keys, len, delta->structkey);
+
+   /* the problem key extends the structure key by the vectors */
+   len = sprintf(keys, "%s %.17g ", delta->structkey, delta->objconst);
+   resultcacheKey(delta->lb, delta->n * sizeof(double), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(delta->ub, delta->n * sizeof(double), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(delta->rhs, delta->m * sizeof(double), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(delta->obj, delta->n * sizeof(double), keys + len);
+   len += RESULTCACHE_KEYLENGTH;
+   resultcacheKey(keys, len, delta->problemkey);
+}
+
+/** allocates a delta with vectors for given dimensions */
+static
+RETURN allocdelta(
+   modeldelta_t** delta,
+   int            n,
+   int            m
+)
+{
+   modeldelta_t* d;
+
+   d = (modeldelta_t*) calloc(1, sizeof(modeldelta_t));
+   if( d == NULL )
+      return RETURN_ERROR;
+
+   d->n = n;
+   d->m = m;
+   d->lb = (double*) malloc((n + 1) * sizeof(double));
+   d->ub = (double*) malloc((n + 1) * sizeof(double));
+   d->rhs = (double*) malloc((m + 1) * sizeof(double));
+   d->obj = (double*) malloc((n + 1) * sizeof(double));
+
+   if( d->lb == NULL || d->ub == NULL || d->rhs == NULL || d->obj == NULL )
+   {
+      modeldeltaFree(&d);
+      return RETURN_ERROR;
+   }
+
+   *delta = d;
+
+   return RETURN_OK;
+}
+
+RETURN modeldeltaCreate(
+   modeldelta_t**     delta,
+   const modelsnap_t* snap
+)
+{
+   modeldelta_t* d;
+
+   assert(delta != NULL);
+   assert(snap != NULL);
+
+   *delta = NULL;
+
+   if( allocdelta(&d, snap->n, snap->m) != RETURN_OK )
+      return RETURN_ERROR;
+
+   memcpy(d->lb, snap->lb, snap->n * sizeof(double));
+   memcpy(d->ub, snap->ub, snap->n * sizeof(double));
+   memcpy(d->rhs, snap->rhs, snap->m * sizeof(double));
+   memcpy(d->obj, snap->obj, snap->n * sizeof(double));
+   d->objconst = snap->objconst;
+
+   computekeys(d, snap);
+
+   *delta = d;
+
+   return RETURN_OK;
+}
+
+RETURN modeldeltaCopy(
+   modeldelta_t**      copy,
+   const modeldelta_t* delta
+)
+{
+   modeldelta_t* d;
+
+   assert(copy != NULL);
+   assert(delta != NULL);
+
+   *copy = NULL;
+
+   if( allocdelta(&d, delta->n, delta->m) != RETURN_OK )
+      return RETURN_ERROR;
+
+   strcpy(d->structkey, delta->structkey);
+   strcpy(d->problemkey, delta->problemkey);
+   memcpy(d->lb, delta->lb, delta->n * sizeof(double));
+   memcpy(d->ub, delta->ub, delta->n * sizeof(double));
+   memcpy(d->rhs, delta->rhs, delta->m * sizeof(double));
+   memcpy(d->obj, delta->obj, delta->n * sizeof(double));
+   d->objconst = delta->objconst;
+
+   *copy = d;
+
+   return RETURN_OK;
+}
+
+void modeldeltaFree(
+   modeldelta_t** delta
+)
+{
+   assert(delta != NULL);
+
+   if( *delta == NULL )
+      return;
+
+   free((*delta)->lb);
+   free((*delta)->ub);
+   free((*delta)->rhs);
+   free((*delta)->obj);
+   free(*delta);
+   *delta = NULL;
+}
+
+RETURN modeldeltaLoad(
+   modeldelta_t** delta,
+   const char*    dir,
+   const char*    structkey
+)
+{
+   char path[4096];
+   char header[sizeof(DELTAFILEHEADER)];
+   modeldelta_t* d = NULL;
+   FILE* file;
+   int n;
+   int m;
+   RETURN rc = RETURN_ERROR;
+
+   assert(delta != NULL);
+   assert(dir != NULL);
+   assert(structkey != NULL);
+
+   *delta = NULL;
+
+   snprintf(path, sizeof(path), "%s/%s.delta", dir, structkey);
+   file = fopen(path, "rb");
+   if( file == NULL )
+      return RETURN_OK;
+
+   if( fread(header, 1, sizeof(DELTAFILEHEADER)-1, file) != sizeof(DELTAFILEHEADER)-1 ||
+      memcmp(header, DELTAFILEHEADER, sizeof(DELTAFILEHEADER)-1) != 0 ||
+      fread(&n, sizeof(int), 1, file) != 1 || fread(&m, sizeof(int), 1, file) != 1 || n < 0 || m < 0 )
+      goto TERMINATE;
+
+   if( allocdelta(&d, n, m) != RETURN_OK )
+      goto TERMINATE;
+
+   strcpy(d->structkey, structkey);
+   if( fread(d->problemkey, 1, RESULTCACHE_KEYLENGTH, file) != RESULTCACHE_KEYLENGTH ||
+      fread(d->lb, sizeof(double), n, file) != (size_t)n ||
+      fread(d->ub, sizeof(double), n, file) != (size_t)n ||
+      fread(d->rhs, sizeof(double), m, file) != (size_t)m ||
+      fread(d->obj, sizeof(double), n, file) != (size_t)n ||
+      fread(&d->objconst, sizeof(double), 1, file) != 1 )
+      goto TERMINATE;
+   d->problemkey[RESULTCACHE_KEYLENGTH] = '\0';
+
+   *delta = d;
+   d = NULL;
+   rc = RETURN_OK;
+
+TERMINATE :
+   modeldeltaFree(&d);
+   fclose(file);
+
+   return rc;
+}
+
+RETURN modeldeltaSave(
+   const modeldelta_t* delta,
+   const char*         dir
+)
+{
+   char path[4096];
+   char tmppath[4096];
+   FILE* file;
+   int ok;
+
+   assert(delta != NULL);
+   assert(dir != NULL);
+
+#ifdef _WIN32
+   if( _mkdir(dir) != 0 && errno != EEXIST )
+#else
+   if( mkdir(dir, 0777) != 0 && errno != EEXIST )
+#endif
+      return RETURN_ERROR;
+
+   snprintf(path, sizeof(path), "%s/%s.delta", dir, delta->structkey);
+   snprintf(tmppath, sizeof(tmppath), "%s/%s.tmp%d", dir, delta->structkey, (int)getpid());
+
+   file = fopen(tmppath, "wb");
+   if( file == NULL )
+      return RETURN_ERROR;
+
+   ok = fwrite(DELTAFILEHEADER, 1, sizeof(DELTAFILEHEADER)-1, file) == sizeof(DELTAFILEHEADER)-1 &&
+      fwrite(&delta->n, sizeof(int), 1, file) == 1 &&
+      fwrite(&delta->m, sizeof(int), 1, file) == 1 &&
+      fwrite(delta->problemkey, 1, RESULTCACHE_KEYLENGTH, file) == RESULTCACHE_KEYLENGTH &&
+      fwrite(delta->lb, sizeof(double), delta->n, file) == (size_t)delta->n &&
+      fwrite(delta->ub, sizeof(double), delta->n, file) == (size_t)delta->n &&
+      fwrite(delta->rhs, sizeof(double), delta->m, file) == (size_t)delta->m &&
+      fwrite(delta->obj, sizeof(double), delta->n, file) == (size_t)delta->n &&
+      fwrite(&delta->objconst, sizeof(double), 1, file) == 1;
+
+   if( fclose(file) != 0 || !ok )
+   {
+      remove(tmppath);
+      return RETURN_ERROR;
+   }
+
+#ifdef _WIN32
+   /* rename() does not replace existing files on Windows */
+   remove(path);
+#endif
+   if( rename(tmppath, path) != 0 )
+   {
+      remove(tmppath);
+      return RETURN_ERROR;
+   }
+
+   return RETURN_OK;
+}
+
+/** counts the entries in which two vectors differ */
+static
+int countchanges(
+   const double* a,
+   const double* b,
+   int           len
+)
+{
+   int count = 0;
+   int i;
+
+   for( i = 0; i < len; ++i )
+      if( a[i] != b[i] )
+         ++count;
+
+   return count;
+}
+
+int modeldeltaCount(
+   const modeldelta_t* base,
+   const modeldelta_t* delta
+)
+{
+   assert(base != NULL);
+   assert(delta != NULL);
+   assert(base->n == delta->n);
+   assert(base->m == delta->m);
+
+   return countchanges(base->lb, delta->lb, delta->n)
+      + countchanges(base->ub, delta->ub, delta->n)
+      + countchanges(base->rhs, delta->rhs, delta->m)
+      + countchanges(base->obj, delta->obj, delta->n)
+      + (base->objconst != delta->objconst);
+}
+
+/** writes a number for the delta */
+static
+RETURN writenumber(
+   double      val,
+   double      infinity,
+   DECL_convertWriteFunc((*writefunc)),
+   void*       writedata
+)
+{
+   char buffer[40];
+
+   if( val >= infinity )
+      strcpy(buffer, "\"inf\"");
+   else if( val <= -infinity )
+      strcpy(buffer, "\"-inf\"");
+   else
+      sprintf(buffer, "%.17g", val);
+
+   return writefunc(buffer, writedata) == 0 ? RETURN_ERROR_WRITEFUNC : RETURN_OK;
+}
+
+/** writes the changed entries of a vector as member of the delta object */
+static
+RETURN writechanges(
+   const char*   name,
+   const double* base,
+   const double* vals,
+   int           len,
+   double        infinity,
+   int*          nmembers,   /**< number of members written so far, to be updated */
+   DECL_convertWriteFunc((*writefunc)),
+   void*         writedata
+)
+{
+   char buffer[100];
+   int nchanges = 0;
+   int i;
+
+   for( i = 0; i < len; ++i )
+   {
+      if( base[i] == vals[i] )
+         continue;
+
+      if( nchanges == 0 )
+         sprintf(buffer, "%s\"%s\":[[%d,", *nmembers > 0 ? "," : "", name, i);
+      else
+         sprintf(buffer, "],[%d,", i);
+      if( writefunc(buffer, writedata) == 0 )
+         return RETURN_ERROR_WRITEFUNC;
+
+      CHECK( writenumber(vals[i], infinity, writefunc, writedata) );
+      ++nchanges;
+   }
+
+   if( nchanges > 0 )
+   {
+      if( writefunc("]]", writedata) == 0 )
+         return RETURN_ERROR_WRITEFUNC;
+      ++*nmembers;
+   }
+
+   return RETURN_OK;
+}
+
+RETURN modeldeltaWriteJSON(
+   const modeldelta_t* base,
+   const modeldelta_t* delta,
+   double              infinity,
+   DECL_convertWriteFunc((*writefunc)),
+   void*               writedata
+)
+{
+   int nmembers = 0;
+
+   assert(base != NULL);
+   assert(delta != NULL);
+   assert(base->n == delta->n);
+   assert(base->m == delta->m);
+
+   if( writefunc("{", writedata) == 0 )
+      return RETURN_ERROR_WRITEFUNC;
+
+   CHECK( writechanges("lb", base->lb, delta->lb, delta->n, infinity, &nmembers, writefunc, writedata) );
+   CHECK( writechanges("ub", base->ub, delta->ub, delta->n, infinity, &nmembers, writefunc, writedata) );
+   CHECK( writechanges("rhs", base->rhs, delta->rhs, delta->m, infinity, &nmembers, writefunc, writedata) );
+   CHECK( writechanges("obj", base->obj, delta->obj, delta->n, infinity, &nmembers, writefunc, writedata) );
+
+   if( base->objconst != delta->objconst )
+   {
+      if( writefunc(nmembers > 0 ? ",\"objconst\":" : "\"objconst\":", writedata) == 0 )
+         return RETURN_ERROR_WRITEFUNC;
+      CHECK( writenumber(delta->objconst, infinity, writefunc, writedata) );
+   }
+
+   if( writefunc("}", writedata) == 0 )
+      return RETURN_ERROR_WRITEFUNC;
+
+   return RETURN_OK;
+}
@@ -0,0 +1,95 @@
+#ifndef MODELDELTA_H_
+#define MODELDELTA_H_
+
+#include "convert.h"  /* for RETURN and DECL_convertWriteFunc */
+#include "modelsnap.h"
+#include "resultcache.h"  /* for RESULTCACHE_KEYLENGTH */
+
+/** the vectors of a linear model that may change between solves of a model with the same structure
+ *
+ * The structure, that is, the types of variables and rows, the matrix, and the objective sense, is identified by a hash.
+ * The vectors of the last submitted model of each structure are kept in a file in a directory,
+ * so that the next solve of a model with this structure, which runs in a new process,
+ * can send only the entries that changed against the problem that SolveEngine already has.
+ */
+typedef struct
+{
+   char        structkey[RESULTCACHE_KEYLENGTH+1];  /**< key of structure of model */
+   char        problemkey[RESULTCACHE_KEYLENGTH+1]; /**< key of structure and vectors, by which SolveEngine keeps the problem */
+   int         n;            /**< number of variables */
+   int         m;            /**< number of rows */
+   double*     lb;           /**< lower bounds of variables */
+   double*     ub;           /**< upper bounds of variables */
+   double*     rhs;          /**< right-hand sides of rows */
+   double*     obj;          /**< coefficients of variables in objective function */
+   double      objconst;     /**< constant of objective function */
+} modeldelta_t;
+
+/** gives whether changes of a model can be sent as delta, which requires the model to be linear */
+extern
+int modeldeltaIsSupported(
+   const modelsnap_t* snap
+);
+
+/** takes the vectors of a snapshot and computes the keys of its structure and its problem */
+extern
+RETURN modeldeltaCreate(
+   modeldelta_t**     delta,
+   const modelsnap_t* snap
+);
+
+/** copies the vectors and keys of a model, so that a variant of it can be made
+ *
+ * The keys are not updated when the vectors of the copy are changed.
+ */
+extern
+RETURN modeldeltaCopy(
+   modeldelta_t**      copy,
+   const modeldelta_t* delta
+);
+
+extern
+void modeldeltaFree(
+   modeldelta_t** delta
+);
+
+/** reads the vectors of the last model with a given structure from a directory, or stores NULL if there is none */
+extern
+RETURN modeldeltaLoad(
+   modeldelta_t** delta,
+   const char*    dir,
+   const char*    structkey
+);
+
+/** writes the vectors of a model into a directory, replacing those of the last model with the same structure
+ *
+ * The directory is created if it does not exist yet.
+ */
+extern
+RETURN modeldeltaSave(
+   const modeldelta_t* delta,
+   const char*         dir
+);
+
+/** gives the number of entries of the vectors that differ between two models of the same structure */
+extern
+int modeldeltaCount(
+   const modeldelta_t* base,
+   const modeldelta_t* delta
+);
+
+/** writes the entries that changed from base to delta as JSON object
+ *
+ * Each vector that changed becomes a member lb, ub, rhs, or obj with an array of [index, value] pairs,
+ * and objconst is given if it changed. Infinite values are written as strings "inf" and "-inf".
+ */
+extern
+RETURN modeldeltaWriteJSON(
+   const modeldelta_t* base,
+   const modeldelta_t* delta,
+   double              infinity,   /**< value of infinity in GMO */
+   DECL_convertWriteFunc((*writefunc)),
+   void*               writedata
+);
+
+#endif /* MODELDELTA_H_ */
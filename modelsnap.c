@@ -0,0 +1,309 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include "modelsnap.h"
+
+#include "gmomcc.h"
+
+#define MINSLICENZ   50000   /**< minimal number of nonzeros that a thread processes when checking a point */
+
+RETURN modelsnapCreate(
+   modelsnap_t**  snap,
+   gmoHandle_t    gmo
+)
+{
+   modelsnap_t* s;
+   int n;
+   int m;
+   int nz;
+
+   assert(snap != NULL);
+   assert(gmo != NULL);
+
+   *snap = NULL;
+
+   n = gmoN(gmo);
+   m = gmoM(gmo);
+   nz = gmoNZ(gmo);
+
+   s = (modelsnap_t*) calloc(1, sizeof(modelsnap_t));
+   if( s == NULL )
+      return RETURN_ERROR;
+
+   s->n = n;
+   s->m = m;
+   s->nz = nz;
+
+   /* allocate at least one element, so that NULL means out of memory */
+   s->lb = (double*) malloc((n + 1) * sizeof(double));
+   s->ub = (double*) malloc((n + 1) * sizeof(double));
+   s->vartype = (int*) malloc((n + 1) * sizeof(int));
+   s->rhs = (double*) malloc((m + 1) * sizeof(double));
+   s->equtype = (int*) malloc((m + 1) * sizeof(int));
+   s->rowstart = (int*) malloc((m + 1) * sizeof(int));
+   s->colidx = (int*) malloc((nz + 1) * sizeof(int));
+   s->val = (double*) malloc((nz + 1) * sizeof(double));
+   s->nlflag = (int*) malloc((nz + 1) * sizeof(int));
+   s->obj = (double*) malloc((n + 1) * sizeof(double));
+
+   if( s->lb == NULL || s->ub == NULL || s->vartype == NULL || s->rhs == NULL || s->equtype == NULL ||
+      s->rowstart == NULL || s->colidx == NULL || s->val == NULL || s->nlflag == NULL || s->obj == NULL )
+   {
+      modelsnapFree(&s);
+      return RETURN_ERROR;
+   }
+
+   gmoGetVarLower(gmo, s->lb);
+   gmoGetVarUpper(gmo, s->ub);
+   gmoGetVarType(gmo, s->vartype);
+   gmoGetRhs(gmo, s->rhs);
+   gmoGetEquType(gmo, s->equtype);
+   gmoGetMatrixRow(gmo, s->rowstart, s->colidx, s->val, s->nlflag);
+   gmoGetObjVector(gmo, s->obj, NULL);
+   s->objconst = gmoObjConst(gmo);
+   s->objsense = gmoSense(gmo);
+
+   *snap = s;
+
+   return RETURN_OK;
+}
+
+void modelsnapFree(
+   modelsnap_t** snap
+)
+{
+   assert(snap != NULL);
+
+   if( *snap == NULL )
+      return;
+
+   free((*snap)->lb);
+   free((*snap)->ub);
+   free((*snap)->vartype);
+   free((*snap)->rhs);
+   free((*snap)->equtype);
+   free((*snap)->rowstart);
+   free((*snap)->colidx);
+   free((*snap)->val);
+   free((*snap)->nlflag);
+   free((*snap)->obj);
+   free(*snap);
+   *snap = NULL;
+}
+
+/** a part of the rows and variables that is checked by one thread */
+typedef struct
+{
+   const modelsnap_t* snap;
+   const double* x;
+   double      tol;
+   double*     activity;     /**< to store row activities, or NULL */
+   int         rowbegin;
+   int         rowend;
+   int         varbegin;
+   int         varend;
+   modelsnapviol_t viol;
+#ifndef _WIN32
+   pthread_t   thread;
+#endif
+   int         threaded;     /**< whether slice is checked by a thread of its own */
+} checkslice_t;
+
+/** computes activities and violations of the rows and variables of a slice */
+static
+void* checkslice(
+   void* data
+)
+{
+   checkslice_t* slice = (checkslice_t*) data;
+   const modelsnap_t* snap = slice->snap;
+   const double* x = slice->x;
+   modelsnapviol_t* viol = &slice->viol;
+   int r;
+   int j;
+   int k;
+
+   for( j = slice->varbegin; j < slice->varend; ++j )
+   {
+      double v = 0.0;
+
+      /* a semicontinuous variable may also be zero */
+      if( x[j] == 0.0 && (snap->vartype[j] == gmovar_SC || snap->vartype[j] == gmovar_SI) )
+         continue;
+
+      if( snap->lb[j] - x[j] > v )
+         v = snap->lb[j] - x[j];
+      if( x[j] - snap->ub[j] > v )
+         v = x[j] - snap->ub[j];
+
+      if( v > viol->maxboundviol )
+      {
+         viol->maxboundviol = v;
+         viol->maxboundvar = j;
+      }
+      if( v > slice->tol )
+         ++viol->nboundviol;
+   }
+
+   for( r = slice->rowbegin; r < slice->rowend; ++r )
+   {
+      double act = 0.0;
+      double v;
+      int isnl = 0;
+
+      for( k = snap->rowstart[r]; k < snap->rowstart[r+1]; ++k )
+      {
+         act += snap->val[k] * x[snap->colidx[k]];
+         isnl |= snap->nlflag[k];
+      }
+
+      if( slice->activity != NULL )
+         slice->activity[r] = act;
+
+      if( isnl )
+      {
+         ++viol->nrowsskipped;
+         continue;
+      }
+
+      switch( snap->equtype[r] )
+      {
+         case gmoequ_E :
+            v = fabs(act - snap->rhs[r]);
+            break;
+         case gmoequ_G :
+            v = snap->rhs[r] - act;
+            break;
+         case gmoequ_L :
+            v = act - snap->rhs[r];
+            break;
+         case gmoequ_N :
+            v = 0.0;
+            break;
+         default :
+            ++viol->nrowsskipped;
+            continue;
+      }
+
+      if( v > viol->maxrowviol )
+      {
+         viol->maxrowviol = v;
+         viol->maxrowidx = r;
+      }
+      if( v > slice->tol )
+         ++viol->nrowviol;
+   }
+
+   return NULL;
+}
+
+/** finds the first row such that the rows before it have at least a given number of nonzeros */
+static
+int findrow(
+   const modelsnap_t* snap,
+   double             nz
+)
+{
+   int lo = 0;
+   int hi = snap->m;
+
+   while( lo < hi )
+   {
+      int mid = lo + (hi - lo) / 2;
+
+      if( snap->rowstart[mid] < nz )
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   return lo;
+}
+
+RETURN modelsnapCheckPoint(
+   const modelsnap_t* snap,
+   const double*      x,
+   double             tol,
+   int                nthreads,
+   double*            activity,
+   modelsnapviol_t*   viol
+)
+{
+   checkslice_t* slices;
+   int t;
+
+   assert(snap != NULL);
+   assert(x != NULL);
+   assert(viol != NULL);
+
+   if( nthreads > (snap->nz + snap->n) / MINSLICENZ )
+      nthreads = (snap->nz + snap->n) / MINSLICENZ;
+   if( nthreads < 1 )
+      nthreads = 1;
+
+   slices = (checkslice_t*) calloc(nthreads, sizeof(checkslice_t));
+   if( slices == NULL )
+      return RETURN_ERROR;
+
+   for( t = 0; t < nthreads; ++t )
+   {
+      slices[t].snap = snap;
+      slices[t].x = x;
+      slices[t].tol = tol;
+      slices[t].activity = activity;
+      slices[t].rowbegin = t == 0 ? 0 : findrow(snap, (double)snap->nz * t / nthreads);
+      slices[t].rowend = t == nthreads-1 ? snap->m : findrow(snap, (double)snap->nz * (t+1) / nthreads);
+      slices[t].varbegin = (int)((double)snap->n * t / nthreads);
+      slices[t].varend = (int)((double)snap->n * (t+1) / nthreads);
+      slices[t].viol.maxboundvar = -1;
+      slices[t].viol.maxrowidx = -1;
+   }
+
+   /* the first slice is checked by the calling thread, as is any slice for which no thread could be started,
+    * and all slices on Windows, where there are no POSIX threads
+    */
+#ifndef _WIN32
+   for( t = 1; t < nthreads; ++t )
+      slices[t].threaded = (pthread_create(&slices[t].thread, NULL, checkslice, &slices[t]) == 0);
+#endif
+   checkslice(&slices[0]);
+   for( t = 1; t < nthreads; ++t )
+#ifndef _WIN32
+      if( slices[t].threaded )
+         pthread_join(slices[t].thread, NULL);
+      else
+#endif
+         checkslice(&slices[t]);
+
+   /* combine slices in order, so that of equal violations the one with smallest index is reported */
+   memset(viol, 0, sizeof(modelsnapviol_t));
+   viol->maxboundvar = -1;
+   viol->maxrowidx = -1;
+   for( t = 0; t < nthreads; ++t )
+   {
+      modelsnapviol_t* sv = &slices[t].viol;
+
+      if( sv->maxboundviol > viol->maxboundviol )
+      {
+         viol->maxboundviol = sv->maxboundviol;
+         viol->maxboundvar = sv->maxboundvar;
+      }
+      if( sv->maxrowviol > viol->maxrowviol )
+      {
+         viol->maxrowviol = sv->maxrowviol;
+         viol->maxrowidx = sv->maxrowidx;
+      }
+      viol->nboundviol += sv->nboundviol;
+      viol->nrowviol += sv->nrowviol;
+      viol->nrowsskipped += sv->nrowsskipped;
+   }
+
+   free(slices);
+
+   return RETURN_OK;
+}
@@ -0,0 +1,71 @@
+#ifndef MODELSNAP_H_
+#define MODELSNAP_H_
+
+#include "convert.h"  /* for RETURN */
+
+struct gmoRec;
+
+/** a snapshot of the linear part of a GAMS instance
+ *
+ * Bounds, types, right-hand sides, and the matrix in compressed row format are read with a few bulk calls to GMO,
+ * so that they can be traversed quickly and from several threads, without any further calls into GMO.
+ */
+typedef struct
+{
+   int         n;            /**< number of variables */
+   int         m;            /**< number of rows */
+   int         nz;           /**< number of nonzeros in matrix */
+   double*     lb;           /**< lower bounds of variables */
+   double*     ub;           /**< upper bounds of variables */
+   int*        vartype;      /**< types of variables (gmovar_*) */
+   double*     rhs;          /**< right-hand sides of rows */
+   int*        equtype;      /**< types of rows (gmoequ_*) */
+   int*        rowstart;     /**< start of each row in colidx and val, and nz at position m */
+   int*        colidx;       /**< column indices of nonzeros */
+   double*     val;          /**< coefficients of nonzeros; for nonlinear nonzeros, a derivative at the current point */
+   int*        nlflag;       /**< whether a nonzero is nonlinear */
+   double*     obj;          /**< coefficients of variables in objective function; for nonlinear objectives, a gradient at the current point */
+   double      objconst;     /**< constant of objective function */
+   int         objsense;     /**< direction of optimization (gmoObj_Min or gmoObj_Max) */
+} modelsnap_t;
+
+/** violation of bounds and rows by a point */
+typedef struct
+{
+   double      maxboundviol; /**< maximal violation of a variable bound */
+   int         maxboundvar;  /**< variable with maximal bound violation, or -1 if there is no violation */
+   int         nboundviol;   /**< number of variables that violate a bound by more than the tolerance */
+   double      maxrowviol;   /**< maximal violation of a row */
+   int         maxrowidx;    /**< row with maximal violation, or -1 if there is no violation */
+   int         nrowviol;     /**< number of rows that are violated by more than the tolerance */
+   int         nrowsskipped; /**< number of rows that have not been checked because they are nonlinear or of a special type */
+} modelsnapviol_t;
+
+/** reads a snapshot of the instance that GMO currently holds, with its index base and row permutation */
+extern
+RETURN modelsnapCreate(
+   modelsnap_t**  snap,
+   struct gmoRec* gmo
+);
+
+extern
+void modelsnapFree(
+   modelsnap_t** snap
+);
+
+/** computes the row activities of a point and how much it violates bounds and rows
+ *
+ * The matrix-vector product and the bound check are split into slices of about equal numbers of nonzeros,
+ * which are processed in parallel if nthreads > 1. The result does not depend on the number of threads.
+ */
+extern
+RETURN modelsnapCheckPoint(
+   const modelsnap_t* snap,
+   const double*      x,          /**< values of variables */
+   double             tol,        /**< tolerance for counting violated bounds and rows */
+   int                nthreads,   /**< maximal number of threads to use */
+   double*            activity,   /**< array of length m to store row activities, or NULL */
+   modelsnapviol_t*   viol        /**< to store violations */
+);
+
+#endif /* MODELSNAP_H_ */
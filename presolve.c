@@ -0,0 +1,278 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "presolve.h"
+
+#include "gmomcc.h"
+
+#define FEASTOL      1e-9    /**< tolerance for feasibility of empty rows and for rounding bounds of integer variables */
+
+int presolveIsSupported(
+   const modelsnap_t* snap
+)
+{
+   int k;
+
+   assert(snap != NULL);
+
+   for( k = 0; k < snap->nz; ++k )
+      if( snap->nlflag[k] )
+         return 0;
+
+   return 1;
+}
+
+/** whether a variable may be removed or get its bounds from a row; semicontinuous and SOS variables are left alone */
+static
+int isreducible(
+   const modelsnap_t* snap,
+   int                j
+)
+{
+   return snap->vartype[j] == gmovar_X || snap->vartype[j] == gmovar_B || snap->vartype[j] == gmovar_I;
+}
+
+/** removes a row that has no variables left, unless it is violated by 0 */
+static
+void reduceemptyrow(
+   presolve_t*        p,
+   const modelsnap_t* snap,
+   int                r
+)
+{
+   double rhs = p->rhs[r];
+   int feasible;
+
+   switch( snap->equtype[r] )
+   {
+      case gmoequ_E :
+         feasible = fabs(rhs) <= FEASTOL;
+         break;
+      case gmoequ_G :
+         feasible = rhs <= FEASTOL;
+         break;
+      case gmoequ_L :
+         feasible = rhs >= -FEASTOL;
+         break;
+      default :
+         return;
+   }
+
+   if( !feasible )
+   {
+      p->infeasible = 1;
+      return;
+   }
+
+   p->rowremoved[r] = 1;
+   ++p->nrowsremoved;
+}
+
+/** turns a row a*x_j (=,>=,<=) rhs into bounds of x_j and removes it */
+static
+void reducesingletonrow(
+   presolve_t*        p,
+   const modelsnap_t* snap,
+   int                r,
+   int                j,
+   double             a
+)
+{
+   double b = p->rhs[r] / a;
+   double tol = FEASTOL * fmax(1.0, fabs(b));
+   double lb = p->lb[j];
+   double ub = p->ub[j];
+   int isint = (snap->vartype[j] != gmovar_X);
+   int type = snap->equtype[r];
+
+   if( !isreducible(snap, j) )
+      return;
+
+   /* dividing a >= or <= row by a negative coefficient flips its direction */
+   if( a < 0.0 && type != gmoequ_E )
+      type = (type == gmoequ_G) ? gmoequ_L : gmoequ_G;
+
+   if( type == gmoequ_E || type == gmoequ_G )
+      lb = fmax(lb, isint ? ceil(b - tol) : b);
+   if( type == gmoequ_E || type == gmoequ_L )
+      ub = fmin(ub, isint ? floor(b + tol) : b);
+
+   if( lb > ub )
+   {
+      if( lb - ub > FEASTOL * fmax(1.0, fabs(lb)) )
+      {
+         p->infeasible = 1;
+         return;
+      }
+      lb = ub;
+   }
+
+   p->lb[j] = lb;
+   p->ub[j] = ub;
+   p->rowremoved[r] = 1;
+   ++p->nrowsremoved;
+}
+
+RETURN presolveCreate(
+   presolve_t**       presolve,
+   const modelsnap_t* snap,
+   double             infinity
+)
+{
+   presolve_t* p;
+   int* newremoved;
+   int changed;
+   int r;
+   int j;
+   int k;
+
+   assert(presolve != NULL);
+   assert(snap != NULL);
+   assert(presolveIsSupported(snap));
+
+   *presolve = NULL;
+
+   p = (presolve_t*) calloc(1, sizeof(presolve_t));
+   if( p == NULL )
+      return RETURN_ERROR;
+
+   p->n = snap->n;
+   p->m = snap->m;
+   p->objconst = snap->objconst;
+
+   /* allocate at least one element, so that NULL means out of memory */
+   p->colremoved = (int*) calloc(snap->n + 1, sizeof(int));
+   p->rowremoved = (int*) calloc(snap->m + 1, sizeof(int));
+   p->lb = (double*) malloc((snap->n + 1) * sizeof(double));
+   p->ub = (double*) malloc((snap->n + 1) * sizeof(double));
+   p->rhs = (double*) malloc((snap->m + 1) * sizeof(double));
+   newremoved = (int*) calloc(snap->n + 1, sizeof(int));
+
+   if( p->colremoved == NULL || p->rowremoved == NULL || p->lb == NULL || p->ub == NULL || p->rhs == NULL || newremoved == NULL )
+   {
+      free(newremoved);
+      presolveFree(&p);
+      return RETURN_ERROR;
+   }
+
+   memcpy(p->lb, snap->lb, snap->n * sizeof(double));
+   memcpy(p->ub, snap->ub, snap->n * sizeof(double));
+   memcpy(p->rhs, snap->rhs, snap->m * sizeof(double));
+
+   /* each round may fix variables by singleton rows, which can make further rows empty or singleton */
+   do
+   {
+      changed = 0;
+
+      for( r = 0; r < snap->m && !p->infeasible; ++r )
+      {
+         int nvars = 0;
+         int last = -1;
+
+         if( p->rowremoved[r] )
+            continue;
+
+         if( snap->equtype[r] == gmoequ_N )
+         {
+            p->rowremoved[r] = 1;
+            ++p->nrowsremoved;
+            changed = 1;
+            continue;
+         }
+
+         for( k = snap->rowstart[r]; k < snap->rowstart[r+1] && nvars < 2; ++k )
+            if( snap->val[k] != 0.0 && !p->colremoved[snap->colidx[k]] )
+            {
+               ++nvars;
+               last = k;
+            }
+
+         if( nvars == 0 )
+            reduceemptyrow(p, snap, r);
+         else if( nvars == 1 )
+            reducesingletonrow(p, snap, r, snap->colidx[last], snap->val[last]);
+
+         changed |= p->rowremoved[r];
+      }
+
+      /* remove fixed variables */
+      for( j = 0; j < snap->n; ++j )
+         if( !p->colremoved[j] && isreducible(snap, j) && p->lb[j] == p->ub[j] && fabs(p->lb[j]) < infinity )
+         {
+            if( snap->vartype[j] != gmovar_X && p->lb[j] != floor(p->lb[j]) )
+            {
+               p->infeasible = 1;
+               break;
+            }
+
+            p->colremoved[j] = 1;
+            newremoved[j] = 1;
+            ++p->ncolsremoved;
+            p->objconst += snap->obj[j] * p->lb[j];
+            changed = 1;
+         }
+
+      /* move contribution of variables removed in this round to the right-hand sides */
+      for( r = 0; r < snap->m; ++r )
+         for( k = snap->rowstart[r]; k < snap->rowstart[r+1]; ++k )
+            if( newremoved[snap->colidx[k]] )
+               p->rhs[r] -= snap->val[k] * p->lb[snap->colidx[k]];
+      memset(newremoved, 0, snap->n * sizeof(int));
+   }
+   while( changed && !p->infeasible );
+
+   for( r = 0; r < snap->m; ++r )
+      for( k = snap->rowstart[r]; k < snap->rowstart[r+1]; ++k )
+         if( p->rowremoved[r] || p->colremoved[snap->colidx[k]] )
+            ++p->nnzremoved;
+
+   free(newremoved);
+
+   *presolve = p;
+
+   return RETURN_OK;
+}
+
+void presolveFree(
+   presolve_t** presolve
+)
+{
+   assert(presolve != NULL);
+
+   if( *presolve == NULL )
+      return;
+
+   free((*presolve)->colremoved);
+   free((*presolve)->rowremoved);
+   free((*presolve)->lb);
+   free((*presolve)->ub);
+   free((*presolve)->rhs);
+   free(*presolve);
+   *presolve = NULL;
+}
+
+int presolveGetNCols(
+   const presolve_t* presolve
+)
+{
+   assert(presolve != NULL);
+
+   return presolve->n - presolve->ncolsremoved;
+}
+
+void presolveRestoreLevels(
+   const presolve_t* presolve,
+   double*           levels
+)
+{
+   int j;
+
+   assert(presolve != NULL);
+   assert(levels != NULL);
+
+   for( j = 0; j < presolve->n; ++j )
+      if( presolve->colremoved[j] )
+         levels[j] = presolve->lb[j];
+}
@@ -0,0 +1,64 @@
+#ifndef PRESOLVE_H_
+#define PRESOLVE_H_
+
+#include "convert.h"  /* for RETURN */
+#include "modelsnap.h"
+
+/** reductions of a linear model that are applied when writing it, and undone when reading its solution
+ *
+ * Fixed variables are removed and their contribution is moved to the right-hand sides and the objective constant.
+ * Free rows and empty rows are removed, and rows with a single variable are turned into bounds of that variable.
+ * Variables and rows keep their indices, so the written model refers to the original names.
+ */
+typedef struct presolve_s
+{
+   int         n;            /**< number of variables */
+   int         m;            /**< number of rows */
+   int*        colremoved;   /**< whether a variable has been removed, in which case it is fixed at its lower bound */
+   int*        rowremoved;   /**< whether a row has been removed */
+   double*     lb;           /**< lower bounds of variables, tightened by singleton rows */
+   double*     ub;           /**< upper bounds of variables, tightened by singleton rows */
+   double*     rhs;          /**< right-hand sides of rows, without the contribution of removed variables */
+   double      objconst;     /**< constant of objective function, with the contribution of removed variables */
+   int         ncolsremoved; /**< number of removed variables */
+   int         nrowsremoved; /**< number of removed rows */
+   int         nnzremoved;   /**< number of removed nonzeros */
+   int         infeasible;   /**< whether the reductions showed that the model is infeasible */
+} presolve_t;
+
+/** gives whether a model can be reduced, which requires the rows to be linear */
+extern
+int presolveIsSupported(
+   const modelsnap_t* snap
+);
+
+/** reduces a model until no more reductions are found
+ *
+ * If a reduction shows that the model is infeasible, the flag infeasible is set and the reductions found so far are kept.
+ */
+extern
+RETURN presolveCreate(
+   presolve_t**       presolve,
+   const modelsnap_t* snap,
+   double             infinity    /**< value of infinity in GMO */
+);
+
+extern
+void presolveFree(
+   presolve_t** presolve
+);
+
+/** gives the number of variables that remain in the reduced model */
+extern
+int presolveGetNCols(
+   const presolve_t* presolve
+);
+
+/** sets the levels of removed variables in a vector of levels of all variables */
+extern
+void presolveRestoreLevels(
+   const presolve_t* presolve,
+   double*           levels
+);
+
+#endif /* PRESOLVE_H_ */
@@ -0,0 +1,464 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#include <direct.h>
+#include <process.h>
+#include <sys/utime.h>
+#define getpid _getpid
+#define utime _utime
+#else
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#endif
+
+#include "resultcache.h"
+
+struct resultcache_s
+{
+   char*       dir;
+   double      maxsize;
+};
+
+/** an entry of the cache, as found when scanning the directory */
+typedef struct
+{
+   char        key[RESULTCACHE_KEYLENGTH+1];
+   double      size;
+   time_t      mtime;
+} cacheentry_t;
+
+RETURN resultcacheCreate(
+   resultcache_t** cache,
+   const char*     dir,
+   double          maxsize
+)
+{
+   struct stat st;
+
+   assert(cache != NULL);
+   assert(dir != NULL);
+
+   *cache = NULL;
+
+#ifdef _WIN32
+   if( _mkdir(dir) != 0 && errno != EEXIST )
+#else
+   if( mkdir(dir, 0777) != 0 && errno != EEXIST )
+#endif
+      return RETURN_ERROR;
+
+   if( stat(dir, &st) != 0 || !(st.st_mode & S_IFDIR) )
+      return RETURN_ERROR;
+
+   *cache = (resultcache_t*) calloc(1, sizeof(resultcache_t));
+   if( *cache == NULL )
+      return RETURN_ERROR;
+
+   (*cache)->dir = strdup(dir);
+   (*cache)->maxsize = maxsize;
+   if( (*cache)->dir == NULL )
+   {
+      resultcacheFree(cache);
+      return RETURN_ERROR;
+   }
+
+   return RETURN_OK;
+}
+
+void resultcacheFree(
+   resultcache_t** cache
+)
+{
+   assert(cache != NULL);
+
+   if( *cache == NULL )
+      return;
+
+   free((*cache)->dir);
+   free(*cache);
+   *cache = NULL;
+}
+
+static
+uint64_t rotl64(
+   uint64_t x,
+   int      r
+)
+{
+   return (x << r) | (x >> (64 - r));
+}
+
+static
+uint64_t fmix64(
+   uint64_t k
+)
+{
+   k ^= k >> 33;
+   k *= 0xff51afd7ed558ccdULL;
+   k ^= k >> 33;
+   k *= 0xc4ceb9fe1a85ec53ULL;
+   k ^= k >> 33;
+
+   return k;
+}
+
+/* MurmurHash3 x64_128 (public domain, by Austin Appleby), which processes 16 bytes per step */
+void resultcacheKey(
+   const void* data,
+   size_t      length,
+   char*       key
+)
+{
+   const unsigned char* bytes = (const unsigned char*) data;
+   const uint64_t c1 = 0x87c37b91114253d5ULL;
+   const uint64_t c2 = 0x4cf5ad432745937fULL;
+   uint64_t h1 = 0;
+   uint64_t h2 = 0;
+   uint64_t k1;
+   uint64_t k2;
+   size_t nblocks = length / 16;
+   size_t i;
+
+   assert(data != NULL || length == 0);
+   assert(key != NULL);
+
+   for( i = 0; i < nblocks; ++i )
+   {
+      /* native byte order, so keys are only comparable between machines of the same endianness */
+      memcpy(&k1, bytes + 16*i, 8);
+      memcpy(&k2, bytes + 16*i + 8, 8);
+
+      k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+      h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+      k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+      h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+   }
+
+   /* remaining up to 15 bytes */
+   k1 = 0;
+   k2 = 0;
+   for( i = length & 15; i > 8; --i )
+      k2 |= (uint64_t)bytes[16*nblocks + i-1] << (8 * (i-9));
+   if( (length & 15) > 8 )
+   {
+      k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+   }
+   for( i = (length & 15) < 8 ? (length & 15) : 8; i > 0; --i )
+      k1 |= (uint64_t)bytes[16*nblocks + i-1] << (8 * (i-1));
+   if( (length & 15) > 0 )
+   {
+      k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+   }
+
+   h1 ^= (uint64_t)length;
+   h2 ^= (uint64_t)length;
+   h1 += h2;
+   h2 += h1;
+   h1 = fmix64(h1);
+   h2 = fmix64(h2);
+   h1 += h2;
+   h2 += h1;
+
+   sprintf(key, "%016llx%016llx", (unsigned long long)h1, (unsigned long long)h2);
+}
+
+/** whether a file name is the one of a cache entry, i.e., a key followed by .json */
+static
+int isentryname(
+   const char* name
+)
+{
+   return strlen(name) == RESULTCACHE_KEYLENGTH + 5
+      && strspn(name, "0123456789abcdef") == RESULTCACHE_KEYLENGTH
+      && strcmp(name + RESULTCACHE_KEYLENGTH, ".json") == 0;
+}
+
+/** reads and increments the number of hits or misses in the stats file of the cache
+ *
+ * Concurrent runs that use the same cache may lose a count, which is acceptable for statistics.
+ */
+static
+void countlookup(
+   resultcache_t* cache,
+   int            hit,
+   int*           nhits,
+   int*           nmisses
+)
+{
+   char path[4096];
+   FILE* file;
+
+   *nhits = 0;
+   *nmisses = 0;
+
+   snprintf(path, sizeof(path), "%s/stats", cache->dir);
+
+   file = fopen(path, "r");
+   if( file != NULL )
+   {
+      if( fscanf(file, "hits %d misses %d", nhits, nmisses) != 2 )
+      {
+         *nhits = 0;
+         *nmisses = 0;
+      }
+      fclose(file);
+   }
+
+   if( hit )
+      ++*nhits;
+   else
+      ++*nmisses;
+
+   file = fopen(path, "w");
+   if( file != NULL )
+   {
+      fprintf(file, "hits %d misses %d\n", *nhits, *nmisses);
+      fclose(file);
+   }
+}
+
+int resultcacheLoad(
+   resultcache_t* cache,
+   const char*    key,
+   char**         data,
+   size_t*        length,
+   int*           nhits,
+   int*           nmisses
+)
+{
+   char path[4096];
+   FILE* file;
+   long size;
+   int hit = 0;
+
+   assert(cache != NULL);
+   assert(key != NULL);
+   assert(data != NULL);
+   assert(length != NULL);
+
+   *data = NULL;
+   *length = 0;
+
+   snprintf(path, sizeof(path), "%s/%s.json", cache->dir, key);
+
+   file = fopen(path, "rb");
+   if( file != NULL )
+   {
+      if( fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0 )
+      {
+         *data = (char*) malloc(size + 1);
+         if( *data != NULL && fread(*data, 1, size, file) == (size_t)size )
+         {
+            (*data)[size] = '\0';
+            *length = (size_t)size;
+            hit = 1;
+         }
+         else
+         {
+            free(*data);
+            *data = NULL;
+         }
+      }
+      fclose(file);
+   }
+
+   /* mark entry as recently used */
+   if( hit )
+      utime(path, NULL);
+
+   countlookup(cache, hit, nhits, nmisses);
+
+   return hit;
+}
+
+/** collects the entries of the cache, gives number of entries or -1 on error */
+static
+int scanentries(
+   resultcache_t* cache,
+   cacheentry_t** entries
+)
+{
+   int nentries = 0;
+   int size = 0;
+#ifdef _WIN32
+   char pattern[4096];
+   struct _finddata_t fd;
+   intptr_t handle;
+
+   *entries = NULL;
+
+   snprintf(pattern, sizeof(pattern), "%s/*.json", cache->dir);
+   handle = _findfirst(pattern, &fd);
+   if( handle == -1 )
+      return 0;
+
+   do
+   {
+      const char* name = fd.name;
+      double filesize = (double)fd.size;
+      time_t mtime = fd.time_write;
+#else
+   DIR* d;
+   struct dirent* de;
+
+   *entries = NULL;
+
+   d = opendir(cache->dir);
+   if( d == NULL )
+      return -1;
+
+   while( (de = readdir(d)) != NULL )
+   {
+      const char* name = de->d_name;
+      char path[4096];
+      struct stat st;
+      double filesize;
+      time_t mtime;
+
+      if( !isentryname(name) )
+         continue;
+
+      snprintf(path, sizeof(path), "%s/%s", cache->dir, name);
+      if( stat(path, &st) != 0 )
+         continue;
+      filesize = (double)st.st_size;
+      mtime = st.st_mtime;
+#endif
+
+      if( isentryname(name) )
+      {
+         if( nentries == size )
+         {
+            cacheentry_t* newentries;
+
+            size = size > 0 ? 2 * size : 64;
+            newentries = (cacheentry_t*) realloc(*entries, size * sizeof(cacheentry_t));
+            if( newentries == NULL )
+            {
+               nentries = -1;
+               break;
+            }
+            *entries = newentries;
+         }
+
+         memcpy((*entries)[nentries].key, name, RESULTCACHE_KEYLENGTH);
+         (*entries)[nentries].key[RESULTCACHE_KEYLENGTH] = '\0';
+         (*entries)[nentries].size = filesize;
+         (*entries)[nentries].mtime = mtime;
+         ++nentries;
+      }
+#ifdef _WIN32
+   }
+   while( _findnext(handle, &fd) == 0 );
+   _findclose(handle);
+#else
+   }
+   closedir(d);
+#endif
+
+   if( nentries < 0 )
+   {
+      free(*entries);
+      *entries = NULL;
+   }
+
+   return nentries;
+}
+
+/** orders cache entries by time of last use */
+static
+int compareentries(
+   const void* a,
+   const void* b
+)
+{
+   const cacheentry_t* ea = (const cacheentry_t*) a;
+   const cacheentry_t* eb = (const cacheentry_t*) b;
+
+   if( ea->mtime != eb->mtime )
+      return ea->mtime < eb->mtime ? -1 : 1;
+   return strcmp(ea->key, eb->key);
+}
+
+RETURN resultcacheStore(
+   resultcache_t* cache,
+   const char*    key,
+   const char*    data,
+   size_t         length,
+   int*           nevicted
+)
+{
+   char path[4096];
+   char tmppath[4096];
+   cacheentry_t* entries = NULL;
+   FILE* file;
+   double total = 0.0;
+   int nentries;
+   int i;
+
+   assert(cache != NULL);
+   assert(key != NULL);
+   assert(data != NULL);
+   assert(nevicted != NULL);
+
+   *nevicted = 0;
+
+   snprintf(path, sizeof(path), "%s/%s.json", cache->dir, key);
+   snprintf(tmppath, sizeof(tmppath), "%s/%s.tmp%d", cache->dir, key, (int)getpid());
+
+   file = fopen(tmppath, "wb");
+   if( file == NULL )
+      return RETURN_ERROR;
+   if( fwrite(data, 1, length, file) != length )
+   {
+      fclose(file);
+      remove(tmppath);
+      return RETURN_ERROR;
+   }
+   if( fclose(file) != 0 )
+   {
+      remove(tmppath);
+      return RETURN_ERROR;
+   }
+
+#ifdef _WIN32
+   /* rename() does not replace existing files on Windows */
+   remove(path);
+#endif
+   if( rename(tmppath, path) != 0 )
+   {
+      remove(tmppath);
+      return RETURN_ERROR;
+   }
+
+   /* evict least recently used entries until the remaining ones fit */
+   nentries = scanentries(cache, &entries);
+   for( i = 0; i < nentries; ++i )
+      total += entries[i].size;
+
+   if( total > cache->maxsize )
+   {
+      qsort(entries, nentries, sizeof(cacheentry_t), compareentries);
+      for( i = 0; i < nentries && total > cache->maxsize; ++i )
+      {
+         snprintf(path, sizeof(path), "%s/%s.json", cache->dir, entries[i].key);
+         if( remove(path) == 0 )
+            ++*nevicted;
+         total -= entries[i].size;
+      }
+   }
+
+   free(entries);
+
+   return RETURN_OK;
+}
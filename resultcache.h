@@ -0,0 +1,65 @@
+#ifndef RESULTCACHE_H_
+#define RESULTCACHE_H_
+
+#include <stddef.h>
+
+#include "convert.h"  /* for RETURN */
+
+#define RESULTCACHE_KEYLENGTH 32    /**< number of hex digits of a key */
+
+/** cache of results of SolveEngine jobs in a local directory
+ *
+ * Each entry is a file that holds the results of a job in the format of a SolveEngine results response.
+ * The name of the file is a 128-bit hash of the submitted problem and options.
+ * The modification time of an entry is updated when it is used, and when the entries together exceed
+ * the maximal size, the ones that have not been used for the longest time are removed.
+ * Numbers of hits and misses are kept in a file stats in the directory.
+ */
+typedef struct resultcache_s resultcache_t;
+
+/** opens a cache in a directory, which is created if it does not exist yet */
+extern
+RETURN resultcacheCreate(
+   resultcache_t** cache,
+   const char*     dir,
+   double          maxsize     /**< maximal total size of entries in bytes */
+);
+
+extern
+void resultcacheFree(
+   resultcache_t** cache
+);
+
+/** computes the key of some data, as RESULTCACHE_KEYLENGTH hex digits and a terminating 0 */
+extern
+void resultcacheKey(
+   const void* data,
+   size_t      length,
+   char*       key         /**< buffer of length at least RESULTCACHE_KEYLENGTH+1 */
+);
+
+/** looks up an entry, gives whether it has been found, and counts a hit or miss */
+extern
+int resultcacheLoad(
+   resultcache_t* cache,
+   const char*    key,
+   char**         data,      /**< to store content of entry, must be freed by caller */
+   size_t*        length,    /**< to store length of entry */
+   int*           nhits,     /**< to store number of hits so far, including this one */
+   int*           nmisses    /**< to store number of misses so far, including this one */
+);
+
+/** stores an entry and evicts the least recently used entries if the cache got too large
+ *
+ * The entry is written to a temporary file first, so that a concurrent lookup never sees a partial entry.
+ */
+extern
+RETURN resultcacheStore(
+   resultcache_t* cache,
+   const char*    key,
+   const char*    data,
+   size_t         length,
+   int*           nevicted   /**< to store number of evicted entries */
+);
+
+#endif /* RESULTCACHE_H_ */
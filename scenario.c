@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "scenario.h"
+
+/** adds an empty scenario to a set */
+static
+RETURN addscenario(
+   scenarioset_t* set,
+   const char*    name
+)
+{
+   scenario_t* scen;
+
+   if( set->nscenarios == set->scenariossize )
+   {
+      int newsize = 2 * set->scenariossize + 8;
+      scenario_t* scenarios = (scenario_t*) realloc(set->scenarios, newsize * sizeof(scenario_t));
+      if( scenarios == NULL )
+         return RETURN_ERROR;
+      set->scenarios = scenarios;
+      set->scenariossize = newsize;
+   }
+
+   scen = &set->scenarios[set->nscenarios++];
+   memset(scen, 0, sizeof(scenario_t));
+   strncpy(scen->name, name, sizeof(scen->name) - 1);
+
+   return RETURN_OK;
+}
+
+/** adds a change to a scenario */
+static
+RETURN addchange(
+   scenario_t*    scen,
+   SCENARIOCHANGE type,
+   int            idx,
+   double         value
+)
+{
+   if( scen->nchanges == scen->changessize )
+   {
+      int newsize = 2 * scen->changessize + 8;
+      scenariochange_t* changes = (scenariochange_t*) realloc(scen->changes, newsize * sizeof(scenariochange_t));
+      if( changes == NULL )
+         return RETURN_ERROR;
+      scen->changes = changes;
+      scen->changessize = newsize;
+   }
+
+   scen->changes[scen->nchanges].type = type;
+   scen->changes[scen->nchanges].idx = idx;
+   scen->changes[scen->nchanges].value = value;
+   ++scen->nchanges;
+
+   return RETURN_OK;
+}
+
+RETURN scenarioRead(
+   scenarioset_t** set,
+   const char*     filename,
+   int             n,
+   int             m,
+   double          infinity,
+   char*           errmsg
+)
+{
+   FILE* f;
+   char line[1024];
+   char keyword[16];
+   char name[256];
+   char value[64];
+   RETURN rc = RETURN_ERROR;
+   int lineno = 0;
+
+   assert(set != NULL);
+   assert(filename != NULL);
+   assert(errmsg != NULL);
+
+   *errmsg = '\0';
+
+   *set = (scenarioset_t*) calloc(1, sizeof(scenarioset_t));
+   if( *set == NULL )
+   {
+      strcpy(errmsg, "Out of memory.");
+      return RETURN_ERROR;
+   }
+
+   f = fopen(filename, "r");
+   if( f == NULL )
+   {
+      snprintf(errmsg, 256, "Could not open file %.200s.", filename);
+      scenarioFree(set);
+      return RETURN_ERROR;
+   }
+
+   while( fgets(line, sizeof(line), f) != NULL )
+   {
+      SCENARIOCHANGE type;
+      char* end;
+      double val;
+      int nfields;
+      int idx;
+
+      ++lineno;
+
+      nfields = sscanf(line, "%15s %255s %63s", keyword, name, value);
+      if( nfields <= 0 || *keyword == '*' )
+         continue;
+
+      if( strcmp(keyword, "scenario") == 0 )
+      {
+         if( nfields != 2 )
+         {
+            snprintf(errmsg, 256, "Line %d: expected 'scenario name'.", lineno);
+            goto TERMINATE;
+         }
+         if( addscenario(*set, name) != RETURN_OK )
+         {
+            strcpy(errmsg, "Out of memory.");
+            goto TERMINATE;
+         }
+         continue;
+      }
+
+      if( strcmp(keyword, "lb") == 0 )
+         type = SCENARIOCHANGE_LB;
+      else if( strcmp(keyword, "ub") == 0 )
+         type = SCENARIOCHANGE_UB;
+      else if( strcmp(keyword, "fx") == 0 )
+         type = SCENARIOCHANGE_FX;
+      else if( strcmp(keyword, "rhs") == 0 )
+         type = SCENARIOCHANGE_RHS;
+      else
+      {
+         snprintf(errmsg, 256, "Line %d: unknown keyword '%s'.", lineno, keyword);
+         goto TERMINATE;
+      }
+
+      if( nfields != 3 )
+      {
+         snprintf(errmsg, 256, "Line %d: expected '%s name value'.", lineno, keyword);
+         goto TERMINATE;
+      }
+
+      if( (*set)->nscenarios == 0 )
+      {
+         snprintf(errmsg, 256, "Line %d: change before first scenario.", lineno);
+         goto TERMINATE;
+      }
+
+      /* names of rows start with e, names of variables with the letter of their type, see convertGetVarName() */
+      idx = convertParseVarIdx(name);
+      if( type == SCENARIOCHANGE_RHS ? (name[0] != 'e' || idx < 0 || idx >= m) : (strchr("xbijy", name[0]) == NULL || idx < 0 || idx >= n) )
+      {
+         snprintf(errmsg, 256, "Line %d: unknown %s '%.100s'.", lineno, type == SCENARIOCHANGE_RHS ? "row" : "variable", name);
+         goto TERMINATE;
+      }
+
+      /* strtod() takes inf and -inf as well */
+      val = strtod(value, &end);
+      if( *end != '\0' || isnan(val) )
+      {
+         snprintf(errmsg, 256, "Line %d: invalid value '%s'.", lineno, value);
+         goto TERMINATE;
+      }
+      if( isinf(val) )
+         val = val > 0.0 ? infinity : -infinity;
+
+      if( addchange(&(*set)->scenarios[(*set)->nscenarios - 1], type, idx, val) != RETURN_OK )
+      {
+         strcpy(errmsg, "Out of memory.");
+         goto TERMINATE;
+      }
+   }
+
+   if( (*set)->nscenarios == 0 )
+   {
+      strcpy(errmsg, "No scenarios in file.");
+      goto TERMINATE;
+   }
+
+   rc = RETURN_OK;
+
+TERMINATE:
+   fclose(f);
+
+   if( rc != RETURN_OK )
+      scenarioFree(set);
+
+   return rc;
+}
+
+void scenarioFree(
+   scenarioset_t** set
+)
+{
+   int s;
+
+   assert(set != NULL);
+
+   if( *set == NULL )
+      return;
+
+   for( s = 0; s < (*set)->nscenarios; ++s )
+      free((*set)->scenarios[s].changes);
+   free((*set)->scenarios);
+   free(*set);
+   *set = NULL;
+}
+
+void scenarioApply(
+   const scenario_t* scenario,
+   modeldelta_t*     delta
+)
+{
+   int k;
+
+   assert(scenario != NULL);
+   assert(delta != NULL);
+
+   for( k = 0; k < scenario->nchanges; ++k )
+   {
+      const scenariochange_t* change = &scenario->changes[k];
+
+      switch( change->type )
+      {
+         case SCENARIOCHANGE_LB :
+            delta->lb[change->idx] = change->value;
+            break;
+         case SCENARIOCHANGE_UB :
+            delta->ub[change->idx] = change->value;
+            break;
+         case SCENARIOCHANGE_FX :
+            delta->lb[change->idx] = change->value;
+            delta->ub[change->idx] = change->value;
+            break;
+         case SCENARIOCHANGE_RHS :
+            delta->rhs[change->idx] = change->value;
+            break;
+      }
+   }
+}
@@ -0,0 +1,71 @@
+#ifndef SCENARIO_H_
+#define SCENARIO_H_
+
+#include "convert.h"  /* for RETURN */
+#include "modeldelta.h"
+
+/** kind of change of a scenario */
+typedef enum
+{
+   SCENARIOCHANGE_LB = 0,    /**< lower bound of a variable */
+   SCENARIOCHANGE_UB,        /**< upper bound of a variable */
+   SCENARIOCHANGE_FX,        /**< lower and upper bound of a variable */
+   SCENARIOCHANGE_RHS        /**< right-hand side of a row */
+} SCENARIOCHANGE;
+
+typedef struct
+{
+   SCENARIOCHANGE type;
+   int            idx;       /**< index of variable or row */
+   double         value;
+} scenariochange_t;
+
+/** a variant of a model that differs from it in some bounds and right-hand sides */
+typedef struct
+{
+   char              name[64];
+   scenariochange_t* changes;
+   int               nchanges;
+   int               changessize;
+} scenario_t;
+
+/** the scenarios of a model, as read from a file
+ *
+ * Each scenario starts with a line "scenario name", followed by lines "lb name value", "ub name value", "fx name value",
+ * or "rhs name value", where the name of a variable or row is the one in the .lp file, e.g., x42 or e7.
+ * Values may be inf or -inf. Empty lines and lines that start with * are ignored.
+ */
+typedef struct
+{
+   scenario_t* scenarios;
+   int         nscenarios;
+   int         scenariossize;
+} scenarioset_t;
+
+/** reads the scenarios of a model with n variables and m rows from a file
+ *
+ * On error, a message that refers to the line of the file is stored in errmsg.
+ */
+extern
+RETURN scenarioRead(
+   scenarioset_t** set,
+   const char*     filename,
+   int             n,
+   int             m,
+   double          infinity,   /**< value of infinity in GMO */
+   char*           errmsg      /**< buffer to store error message, must have length at least 256 */
+);
+
+extern
+void scenarioFree(
+   scenarioset_t** set
+);
+
+/** changes the vectors of a model as a scenario says */
+extern
+void scenarioApply(
+   const scenario_t* scenario,
+   modeldelta_t*     delta
+);
+
+#endif /* SCENARIO_H_ */
@@ -0,0 +1,1422 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <assert.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOLREADER_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "solreader.h"
+#include "fastfloat.h"
+
+#define MAXDEPTH     64      /**< maximal nesting of arrays and objects */
+#define MAXTOKENLEN  256     /**< longer strings are truncated, as we only need short ones */
+#define MAXNUMBERLEN FASTFLOAT_MAXLEN
+#define HEADSIZE     1024
+#define MINSLICEVARS 10000   /**< minimal number of variables that a thread converts when reading via structural index */
+
+/** meaning of an object or array in the response */
+typedef enum
+{
+   ROLE_OTHER = 0,
+   ROLE_ROOT,                /**< the response object */
+   ROLE_RESULT,              /**< object "result" */
+   ROLE_VARIABLES,           /**< array "result.variables" */
+   ROLE_VARIABLE             /**< an element of "result.variables" */
+} ROLE;
+
+/** keys of object members that we are interested in */
+typedef enum
+{
+   KEY_OTHER = 0,
+   KEY_RESULT,
+   KEY_STATUS,
+   KEY_OBJVAL,
+   KEY_VARIABLES,
+   KEY_NAME,
+   KEY_VALUE
+} KEY;
+
+/** what the lexer is reading */
+typedef enum
+{
+   LEX_BETWEEN = 0,          /**< whitespace or structural characters */
+   LEX_STRING,
+   LEX_ESCAPE,               /**< character after backslash in string */
+   LEX_UNICODE,              /**< hex digits of \u escape in string */
+   LEX_NUMBER,
+   LEX_LITERAL,              /**< true, false, null */
+   LEX_ERROR                 /**< parse error, ignore remaining data */
+} LEX;
+
+/** what the parser expects as next token */
+typedef enum
+{
+   EXPECT_VALUE = 0,
+   EXPECT_VALUEORCLOSE,      /**< value or end of array */
+   EXPECT_KEY,
+   EXPECT_KEYORCLOSE,        /**< key or end of object */
+   EXPECT_COLON,
+   EXPECT_COMMAORCLOSE,      /**< separator or end of array or object */
+   EXPECT_END                /**< only whitespace after the response object */
+} EXPECT;
+
+/** an array or object that is currently parsed */
+typedef struct
+{
+   int         isobject;
+   ROLE        role;
+   KEY         key;          /**< key of current member of object */
+} container_t;
+
+struct solreader_s
+{
+   int         nlevels;      /**< number of variables in GAMS instance */
+   double*     levels;
+   int         nthreads;     /**< number of threads for converting variables when reading via structural index */
+
+   /* parser state */
+   LEX         lex;
+   EXPECT      expect;
+   int         iskey;        /**< whether the string that is read is a key */
+   int         nunicode;     /**< number of hex digits read of \u escape */
+   char        token[MAXTOKENLEN];
+   int         tokenlen;
+   container_t stack[MAXDEPTH];
+   int         depth;
+
+   /* variable that is currently parsed */
+   int         varidx;       /**< index of variable, or -1 if no name seen yet */
+   double      varvalue;
+   int         hasvalue;
+
+   /* results */
+   char        status[MAXTOKENLEN];
+   int         hasstatus;
+   double      objval;
+   int         hasobjval;
+   int         nvars;        /**< number of variables read, or -1 if no variables array seen */
+
+   char        error[MAXTOKENLEN + 64];
+   char        head[HEADSIZE];
+   size_t      headlen;
+   size_t      length;       /**< number of bytes of response seen so far */
+};
+
+RETURN solreaderCreate(
+   solreader_t** reader,
+   int           nvars
+)
+{
+   assert(reader != NULL);
+   assert(nvars >= 0);
+
+   *reader = (solreader_t*) calloc(1, sizeof(solreader_t));
+   if( *reader == NULL )
+      return RETURN_ERROR;
+
+   (*reader)->nlevels = nvars;
+   (*reader)->levels = (double*) calloc(nvars > 0 ? nvars : 1, sizeof(double));
+   if( (*reader)->levels == NULL )
+   {
+      free(*reader);
+      *reader = NULL;
+      return RETURN_ERROR;
+   }
+
+   solreaderReset(*reader);
+
+   return RETURN_OK;
+}
+
+void solreaderFree(
+   solreader_t** reader
+)
+{
+   assert(reader != NULL);
+
+   if( *reader == NULL )
+      return;
+
+   free((*reader)->levels);
+   free(*reader);
+   *reader = NULL;
+}
+
+void solreaderReset(
+   solreader_t* reader
+)
+{
+   assert(reader != NULL);
+
+   reader->lex = LEX_BETWEEN;
+   reader->expect = EXPECT_VALUE;
+   reader->depth = 0;
+   reader->tokenlen = 0;
+   reader->varidx = -1;
+   reader->hasvalue = 0;
+   reader->hasstatus = 0;
+   reader->hasobjval = 0;
+   reader->nvars = -1;
+   reader->headlen = 0;
+   reader->length = 0;
+   *reader->head = '\0';
+   *reader->error = '\0';
+}
+
+/** stores a parse error; the remaining response is ignored */
+static
+void seterror(
+   solreader_t* reader,
+   const char*  msg,
+   const char*  detail
+)
+{
+   if( reader->lex == LEX_ERROR )
+      return;
+
+   if( detail != NULL )
+      snprintf(reader->error, sizeof(reader->error), "%s %s", msg, detail);
+   else
+      snprintf(reader->error, sizeof(reader->error), "%s", msg);
+   reader->lex = LEX_ERROR;
+}
+
+/** compares a key case-insensitively, as cJSON_GetObjectItem() does */
+static
+int iskey(
+   const char* token,
+   const char* key
+)
+{
+   while( *token != '\0' && tolower((unsigned char)*token) == *key )
+   {
+      ++token;
+      ++key;
+   }
+   return *token == '\0' && *key == '\0';
+}
+
+/** identifies the key of an object member, only keys that matter in this object are considered */
+static
+KEY identifykey(
+   ROLE        role,
+   const char* token
+)
+{
+   switch( role )
+   {
+      case ROLE_ROOT :
+         if( iskey(token, "result") )
+            return KEY_RESULT;
+         break;
+      case ROLE_RESULT :
+         if( iskey(token, "status") )
+            return KEY_STATUS;
+         if( iskey(token, "objective_value") )
+            return KEY_OBJVAL;
+         if( iskey(token, "variables") )
+            return KEY_VARIABLES;
+         break;
+      case ROLE_VARIABLE :
+         if( iskey(token, "name") )
+            return KEY_NAME;
+         if( iskey(token, "value") )
+            return KEY_VALUE;
+         break;
+      default :
+         break;
+   }
+
+   return KEY_OTHER;
+}
+
+/** parses the number in token, or returns 0 if it is not a valid number */
+static
+int parsenumber(
+   solreader_t* reader,
+   double*      value
+)
+{
+   return reader->tokenlen > 0 && fastfloatParse(reader->token, reader->tokenlen, value) == (size_t)reader->tokenlen;
+}
+
+/** updates expectation after a value has been completed */
+static
+void aftervalue(
+   solreader_t* reader
+)
+{
+   reader->expect = reader->depth > 0 ? EXPECT_COMMAORCLOSE : EXPECT_END;
+}
+
+/** processes a complete string, number, or literal value */
+static
+void processscalar(
+   solreader_t* reader,
+   LEX          lex
+)
+{
+   container_t* top;
+
+   assert(reader->tokenlen < MAXTOKENLEN);
+   reader->token[reader->tokenlen] = '\0';
+
+   if( reader->depth == 0 )
+   {
+      seterror(reader, "Results are not a JSON object.", NULL);
+      return;
+   }
+
+   top = &reader->stack[reader->depth-1];
+   if( top->isobject )
+   {
+      switch( top->key )
+      {
+         case KEY_STATUS :
+            if( lex == LEX_STRING )
+            {
+               strcpy(reader->status, reader->token);
+               reader->hasstatus = 1;
+            }
+            break;
+
+         case KEY_OBJVAL :
+            if( lex == LEX_NUMBER && !parsenumber(reader, &reader->objval) )
+               seterror(reader, "Error parsing objective value", reader->token);
+            reader->hasobjval = (lex == LEX_NUMBER);
+            break;
+
+         case KEY_NAME :
+            if( lex != LEX_STRING )
+               break;
+            reader->varidx = convertParseVarIdx(reader->token);
+            if( reader->varidx < 0 || reader->varidx >= reader->nlevels )
+               seterror(reader, "Error parsing variable result", reader->token);
+            break;
+
+         case KEY_VALUE :
+            if( lex == LEX_NUMBER )
+            {
+               if( !parsenumber(reader, &reader->varvalue) )
+                  seterror(reader, "Error parsing variable result", reader->token);
+               reader->hasvalue = 1;
+            }
+            break;
+
+         default :
+            break;
+      }
+   }
+
+   aftervalue(reader);
+}
+
+/** checks that name and value of a variable have been parsed */
+static
+RETURN checkvariable(
+   solreader_t* reader
+)
+{
+   if( reader->varidx < 0 )
+   {
+      seterror(reader, "No 'name' in variable result.", NULL);
+      return RETURN_ERROR;
+   }
+   if( !reader->hasvalue )
+   {
+      seterror(reader, "No 'value' in variable result.", NULL);
+      return RETURN_ERROR;
+   }
+
+   return RETURN_OK;
+}
+
+/** stores the value of the variable that has been parsed completely */
+static
+RETURN storevariable(
+   solreader_t* reader
+)
+{
+   if( checkvariable(reader) != RETURN_OK )
+      return RETURN_ERROR;
+
+   reader->levels[reader->varidx] = reader->varvalue;
+   ++reader->nvars;
+
+   return RETURN_OK;
+}
+
+/** starts an array or object */
+static
+void pushcontainer(
+   solreader_t* reader,
+   int          isobject
+)
+{
+   container_t* parent;
+   container_t* top;
+
+   if( reader->depth == MAXDEPTH )
+   {
+      seterror(reader, "Results nested too deeply.", NULL);
+      return;
+   }
+
+   parent = reader->depth > 0 ? &reader->stack[reader->depth-1] : NULL;
+   top = &reader->stack[reader->depth++];
+   top->isobject = isobject;
+   top->key = KEY_OTHER;
+   top->role = ROLE_OTHER;
+
+   if( parent == NULL )
+   {
+      if( !isobject )
+         seterror(reader, "Results are not a JSON object.", NULL);
+      top->role = ROLE_ROOT;
+   }
+   else if( parent->role == ROLE_ROOT && parent->key == KEY_RESULT && isobject )
+      top->role = ROLE_RESULT;
+   else if( parent->role == ROLE_RESULT && parent->key == KEY_VARIABLES && !isobject )
+   {
+      top->role = ROLE_VARIABLES;
+      reader->nvars = 0;
+   }
+   else if( parent->role == ROLE_VARIABLES && isobject )
+   {
+      top->role = ROLE_VARIABLE;
+      reader->varidx = -1;
+      reader->hasvalue = 0;
+   }
+
+   reader->expect = isobject ? EXPECT_KEYORCLOSE : EXPECT_VALUEORCLOSE;
+}
+
+/** ends an array or object */
+static
+void popcontainer(
+   solreader_t* reader
+)
+{
+   container_t* top;
+
+   assert(reader->depth > 0);
+   top = &reader->stack[--reader->depth];
+
+   if( top->role == ROLE_VARIABLE && storevariable(reader) != RETURN_OK )
+      return;
+
+   aftervalue(reader);
+}
+
+/** processes a character between tokens, possibly starting a new token */
+static
+void processbetween(
+   solreader_t* reader,
+   char         c
+)
+{
+   switch( c )
+   {
+      case ' ' :
+      case '\t' :
+      case '\n' :
+      case '\r' :
+         return;
+
+      case '{' :
+      case '[' :
+         if( reader->expect != EXPECT_VALUE && reader->expect != EXPECT_VALUEORCLOSE )
+            break;
+         pushcontainer(reader, c == '{');
+         return;
+
+      case '}' :
+      case ']' :
+         if( reader->depth == 0 || reader->stack[reader->depth-1].isobject != (c == '}') )
+            break;
+         if( reader->expect != EXPECT_COMMAORCLOSE && reader->expect != (c == '}' ? EXPECT_KEYORCLOSE : EXPECT_VALUEORCLOSE) )
+            break;
+         popcontainer(reader);
+         return;
+
+      case ':' :
+         if( reader->expect != EXPECT_COLON )
+            break;
+         reader->expect = EXPECT_VALUE;
+         return;
+
+      case ',' :
+         if( reader->expect != EXPECT_COMMAORCLOSE )
+            break;
+         reader->expect = reader->stack[reader->depth-1].isobject ? EXPECT_KEY : EXPECT_VALUE;
+         return;
+
+      case '"' :
+         if( reader->expect == EXPECT_KEY || reader->expect == EXPECT_KEYORCLOSE )
+            reader->iskey = 1;
+         else if( reader->expect == EXPECT_VALUE || reader->expect == EXPECT_VALUEORCLOSE )
+            reader->iskey = 0;
+         else
+            break;
+         reader->lex = LEX_STRING;
+         reader->tokenlen = 0;
+         return;
+
+      default :
+         if( reader->expect != EXPECT_VALUE && reader->expect != EXPECT_VALUEORCLOSE )
+            break;
+         if( c == '-' || (c >= '0' && c <= '9') )
+            reader->lex = LEX_NUMBER;
+         else if( c == 't' || c == 'f' || c == 'n' )
+            reader->lex = LEX_LITERAL;
+         else
+            break;
+         reader->token[0] = c;
+         reader->tokenlen = 1;
+         return;
+   }
+
+   {
+      char detail[2] = { c, '\0' };
+      seterror(reader, "Unexpected character in results:", detail);
+   }
+}
+
+/** appends a character to the current token, truncating long strings */
+static
+void appendtoken(
+   solreader_t* reader,
+   char         c
+)
+{
+   if( reader->tokenlen < MAXTOKENLEN-1 )
+      reader->token[reader->tokenlen++] = c;
+}
+
+/** processes a piece of the response */
+static
+void processdata(
+   solreader_t* reader,
+   const char*  data,
+   size_t       length
+)
+{
+   size_t i = 0;
+
+   while( i < length && reader->lex != LEX_ERROR )
+   {
+      char c = data[i];
+
+      switch( reader->lex )
+      {
+         case LEX_BETWEEN :
+            processbetween(reader, c);
+            break;
+
+         case LEX_STRING :
+            if( c == '"' )
+            {
+               reader->lex = LEX_BETWEEN;
+               if( reader->iskey )
+               {
+                  container_t* top = &reader->stack[reader->depth-1];
+                  reader->token[reader->tokenlen] = '\0';
+                  top->key = identifykey(top->role, reader->token);
+                  reader->expect = EXPECT_COLON;
+               }
+               else
+                  processscalar(reader, LEX_STRING);
+            }
+            else if( c == '\\' )
+               reader->lex = LEX_ESCAPE;
+            else
+               appendtoken(reader, c);
+            break;
+
+         case LEX_ESCAPE :
+            reader->lex = LEX_STRING;
+            switch( c )
+            {
+               case 'b' : appendtoken(reader, '\b'); break;
+               case 'f' : appendtoken(reader, '\f'); break;
+               case 'n' : appendtoken(reader, '\n'); break;
+               case 'r' : appendtoken(reader, '\r'); break;
+               case 't' : appendtoken(reader, '\t'); break;
+               case 'u' :
+                  /* we do not need non-ASCII characters, so replace them */
+                  appendtoken(reader, '?');
+                  reader->nunicode = 0;
+                  reader->lex = LEX_UNICODE;
+                  break;
+               default :  /* ", \, / */
+                  appendtoken(reader, c);
+                  break;
+            }
+            break;
+
+         case LEX_UNICODE :
+            if( !isxdigit((unsigned char)c) )
+            {
+               seterror(reader, "Invalid unicode escape in results.", NULL);
+               break;
+            }
+            if( ++reader->nunicode == 4 )
+               reader->lex = LEX_STRING;
+            break;
+
+         case LEX_NUMBER :
+         case LEX_LITERAL :
+            if( reader->lex == LEX_NUMBER ? ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') : (c >= 'a' && c <= 'z') )
+            {
+               if( reader->tokenlen == (reader->lex == LEX_NUMBER ? MAXNUMBERLEN : 8) )
+               {
+                  seterror(reader, "Too long token in results.", NULL);
+                  break;
+               }
+               reader->token[reader->tokenlen++] = c;
+               break;
+            }
+
+            /* token ends before this character */
+            if( reader->lex == LEX_LITERAL )
+            {
+               reader->token[reader->tokenlen] = '\0';
+               if( strcmp(reader->token, "true") != 0 && strcmp(reader->token, "false") != 0 && strcmp(reader->token, "null") != 0 )
+               {
+                  seterror(reader, "Unexpected token in results:", reader->token);
+                  break;
+               }
+            }
+            processscalar(reader, reader->lex);
+            if( reader->lex != LEX_ERROR )
+               reader->lex = LEX_BETWEEN;
+            continue;  /* process this character again */
+
+         case LEX_ERROR :
+            assert(0);
+            break;
+      }
+
+      ++i;
+   }
+}
+
+/*
+ * reading results from a complete document via a structural index
+ */
+
+/** positions of the structural characters of a document and of the beginnings of strings and scalars */
+typedef struct
+{
+   const char* json;
+   size_t      length;
+   uint32_t*   pos;
+   size_t      npos;
+   size_t      possize;
+   size_t      i;            /**< position in pos that is visited next */
+} jsonindex_t;
+
+/** gets a mask of the characters in a block of 64 characters that equal c */
+#ifdef SOLREADER_SSE2
+#define MATCH16(v, c) ((uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8((v), _mm_set1_epi8(c))))
+#endif
+
+/** classifies the characters of a block of 64 characters
+ *
+ * Structural characters are {}[]:, and brackets are found by one comparison each,
+ * as '[' | 0x20 == '{' and ']' | 0x20 == '}'.
+ */
+static
+void classifyblock(
+   const unsigned char* block,
+   uint64_t*   quote,
+   uint64_t*   backslash,
+   uint64_t*   op,
+   uint64_t*   space
+)
+{
+   int k;
+
+   *quote = 0;
+   *backslash = 0;
+   *op = 0;
+   *space = 0;
+
+#ifdef SOLREADER_SSE2
+   for( k = 0; k < 4; ++k )
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)(block + 16*k));
+      __m128i v20 = _mm_or_si128(v, _mm_set1_epi8(0x20));
+      int shift = 16*k;
+
+      *quote |= MATCH16(v, '"') << shift;
+      *backslash |= MATCH16(v, '\\') << shift;
+      *op |= (MATCH16(v20, '{') | MATCH16(v20, '}') | MATCH16(v, ':') | MATCH16(v, ',')) << shift;
+      *space |= (MATCH16(v, ' ') | MATCH16(v, '\t') | MATCH16(v, '\n') | MATCH16(v, '\r')) << shift;
+   }
+#else
+   for( k = 0; k < 64; ++k )
+   {
+      uint64_t bit = (uint64_t)1 << k;
+
+      switch( block[k] )
+      {
+         case '"' : *quote |= bit; break;
+         case '\\' : *backslash |= bit; break;
+         case '{' : case '}' : case '[' : case ']' : case ':' : case ',' : *op |= bit; break;
+         case ' ' : case '\t' : case '\n' : case '\r' : *space |= bit; break;
+         default : break;
+      }
+   }
+#endif
+}
+
+/** counts trailing zero bits of a nonzero integer */
+static
+int trailingzeros(
+   uint64_t x
+)
+{
+#if defined(__GNUC__)
+   return __builtin_ctzll(x);
+#else
+   int n = 0;
+
+   assert(x != 0);
+   while( !(x & 1) )
+   {
+      x >>= 1;
+      ++n;
+   }
+   return n;
+#endif
+}
+
+/** finds the structural positions of a document in one pass over blocks of 64 characters
+ *
+ * For each block, bit masks of quotes, backslashes, structural characters, and whitespace are computed.
+ * The mask of characters inside strings is then the prefix-XOR of the unescaped quotes.
+ * Kept are structural characters outside of strings, opening quotes, and the first character of each scalar.
+ */
+static
+RETURN buildindex(
+   jsonindex_t* index
+)
+{
+   unsigned char lastblock[64];
+   uint64_t previnstring = 0;     /* all ones if previous block ended inside a string */
+   uint64_t prevescape = 0;       /* 1 if first character of block is escaped */
+   uint64_t prevscalar = 0;       /* 1 if previous block ended with a scalar character */
+   size_t base;
+
+   if( index->length >= UINT32_MAX )
+      return RETURN_ERROR;
+
+   index->npos = 0;
+   index->i = 0;
+
+   for( base = 0; base < index->length; base += 64 )
+   {
+      const unsigned char* block;
+      uint64_t quote;
+      uint64_t backslash;
+      uint64_t op;
+      uint64_t space;
+      uint64_t escaped;
+      uint64_t instring;
+      uint64_t scalar;
+      uint64_t structural;
+
+      if( index->length - base >= 64 )
+         block = (const unsigned char*)index->json + base;
+      else
+      {
+         /* pad last block with whitespace */
+         memset(lastblock, ' ', sizeof(lastblock));
+         memcpy(lastblock, index->json + base, index->length - base);
+         block = lastblock;
+      }
+
+      classifyblock(block, &quote, &backslash, &op, &space);
+
+      /* characters after an odd number of backslashes are escaped; backslashes are rare in results, so walk them one by one */
+      escaped = prevescape;
+      if( backslash != 0 )
+      {
+         uint64_t bs = backslash & ~prevescape;
+
+         while( bs != 0 )
+         {
+            int k = trailingzeros(bs);
+
+            if( k == 63 )
+            {
+               prevescape = 1;
+               break;
+            }
+            escaped |= (uint64_t)1 << (k+1);
+            bs &= ~((uint64_t)3 << k);
+         }
+         if( bs == 0 )
+            prevescape = 0;
+      }
+      else
+         prevescape = 0;
+      quote &= ~escaped;
+
+      /* prefix-XOR of quotes: bits from an opening quote until before the closing quote */
+      instring = quote;
+      instring ^= instring << 1;
+      instring ^= instring << 2;
+      instring ^= instring << 4;
+      instring ^= instring << 8;
+      instring ^= instring << 16;
+      instring ^= instring << 32;
+      instring ^= previnstring;
+      previnstring = (instring >> 63) ? ~(uint64_t)0 : 0;
+
+      op &= ~instring;
+      scalar = ~(op | space | quote | instring);
+      structural = op | (quote & instring) | (scalar & ~((scalar << 1) | prevscalar));
+      prevscalar = scalar >> 63;
+
+      /* do not index padding */
+      if( index->length - base < 64 )
+         structural &= ((uint64_t)1 << (index->length - base)) - 1;
+
+      /* append positions */
+      if( index->npos + 64 > index->possize )
+      {
+         uint32_t* newpos;
+         size_t newsize;
+
+         newsize = 2 * index->possize + 1024;
+         newpos = (uint32_t*) realloc(index->pos, newsize * sizeof(uint32_t));
+         if( newpos == NULL )
+            return RETURN_ERROR;
+         index->pos = newpos;
+         index->possize = newsize;
+      }
+      while( structural != 0 )
+      {
+         index->pos[index->npos++] = (uint32_t)(base + trailingzeros(structural));
+         structural &= structural - 1;
+      }
+   }
+
+   return previnstring == 0 ? RETURN_OK : RETURN_ERROR;
+}
+
+/** gives the character at the current position of the index, or '\0' if at end */
+static
+char currentchar(
+   jsonindex_t* index
+)
+{
+   return index->i < index->npos ? index->json[index->pos[index->i]] : '\0';
+}
+
+/** copies the string at the current position into the token of the reader */
+static
+void readstring(
+   solreader_t* reader,
+   jsonindex_t* index
+)
+{
+   const char* p = index->json + index->pos[index->i] + 1;
+   const char* end = index->json + index->length;
+
+   reader->tokenlen = 0;
+   while( p < end && *p != '"' )
+   {
+      if( *p == '\\' && p+1 < end )
+      {
+         ++p;
+         switch( *p )
+         {
+            case 'b' : appendtoken(reader, '\b'); break;
+            case 'f' : appendtoken(reader, '\f'); break;
+            case 'n' : appendtoken(reader, '\n'); break;
+            case 'r' : appendtoken(reader, '\r'); break;
+            case 't' : appendtoken(reader, '\t'); break;
+            case 'u' : appendtoken(reader, '?'); p += 4; break;
+            default : appendtoken(reader, *p); break;
+         }
+      }
+      else
+         appendtoken(reader, *p);
+      ++p;
+   }
+   reader->token[reader->tokenlen] = '\0';
+
+   ++index->i;
+}
+
+/** parses the number at the current position
+ *
+ * @return whether there is a number
+ */
+static
+int readnumber(
+   jsonindex_t* index,
+   double*      value
+)
+{
+   size_t start = index->pos[index->i];
+   size_t end = index->i+1 < index->npos ? index->pos[index->i+1] : index->length;
+   size_t n;
+
+   ++index->i;
+
+   n = fastfloatParse(index->json + start, end - start, value);
+   if( n == 0 )
+      return 0;
+
+   /* only whitespace may follow until the next structural character */
+   for( start += n; start < end; ++start )
+      if( index->json[start] != ' ' && index->json[start] != '\t' && index->json[start] != '\n' && index->json[start] != '\r' )
+         return 0;
+
+   return 1;
+}
+
+/** skips the value at the current position */
+static
+RETURN skipvalue(
+   jsonindex_t* index
+)
+{
+   int depth = 0;
+
+   do
+   {
+      switch( currentchar(index) )
+      {
+         case '{' :
+         case '[' :
+            ++depth;
+            break;
+         case '}' :
+         case ']' :
+            --depth;
+            break;
+         case '\0' :
+            return RETURN_ERROR;
+         default :
+            break;
+      }
+      ++index->i;
+   }
+   while( depth > 0 );
+
+   return RETURN_OK;
+}
+
+static
+RETURN walkobject(
+   solreader_t* reader,
+   jsonindex_t* index,
+   ROLE         role
+);
+
+/** a part of the array of variables that is converted by one thread */
+typedef struct
+{
+   const solreader_t* reader;
+   const jsonindex_t* index;
+   const uint32_t* records;  /**< position in index of each variable object */
+   int         begin;        /**< first variable of slice */
+   int         end;          /**< variable after last one of slice */
+   int*        varidx;       /**< to store index of each variable */
+   double*     values;       /**< to store value of each variable */
+#ifndef _WIN32
+   pthread_t   thread;
+#endif
+   int         threaded;     /**< whether slice is converted by a thread of its own */
+   int         failed;
+   char        error[MAXTOKENLEN + 64];
+} varslice_t;
+
+/** parses names and values of the variables of a slice */
+static
+void* convertslice(
+   void* data
+)
+{
+   varslice_t* slice = (varslice_t*) data;
+   solreader_t* reader;
+   jsonindex_t index;
+   int k;
+
+   /* visiting an object needs a reader for its tokens, which cannot be shared between threads */
+   reader = (solreader_t*) malloc(sizeof(solreader_t));
+   if( reader == NULL )
+   {
+      slice->failed = 1;
+      strcpy(slice->error, "Out of memory.");
+      return NULL;
+   }
+   reader->nlevels = slice->reader->nlevels;
+   reader->levels = NULL;
+   reader->lex = LEX_BETWEEN;
+   *reader->error = '\0';
+
+   index = *slice->index;
+
+   for( k = slice->begin; k < slice->end; ++k )
+   {
+      index.i = slice->records[k];
+      reader->varidx = -1;
+      reader->hasvalue = 0;
+      if( walkobject(reader, &index, ROLE_VARIABLE) != RETURN_OK || checkvariable(reader) != RETURN_OK )
+      {
+         slice->failed = 1;
+         strcpy(slice->error, reader->error);
+         break;
+      }
+      slice->varidx[k] = reader->varidx;
+      slice->values[k] = reader->varvalue;
+   }
+
+   free(reader);
+
+   return NULL;
+}
+
+/** visits the array of variables at the current position and stores their values, using several threads
+ *
+ * First, the beginning of each variable object is located, which needs only the structural index.
+ * Then the variables are split into contiguous slices, and each thread parses names and values of its slice
+ * into its part of arrays of indices and values. Finally, the values are stored in the order of the document,
+ * so the levels are exactly the same as with a sequential walk, also if a variable appears more than once.
+ */
+static
+RETURN walkvariablesparallel(
+   solreader_t* reader,
+   jsonindex_t* index
+)
+{
+   varslice_t* slices = NULL;
+   uint32_t* records = NULL;
+   int* varidx = NULL;
+   double* values = NULL;
+   int nrecords = 0;
+   int recordssize = 0;
+   int nthreads;
+   int t;
+   int k;
+   RETURN rc = RETURN_ERROR;
+
+   assert(currentchar(index) == '[');
+   ++index->i;
+
+   if( currentchar(index) != ']' )
+      for( ;; )
+      {
+         if( currentchar(index) != '{' )
+            goto TERMINATE;
+
+         if( nrecords == recordssize )
+         {
+            uint32_t* newrecords;
+
+            recordssize = 2 * recordssize + 1024;
+            newrecords = (uint32_t*) realloc(records, recordssize * sizeof(uint32_t));
+            if( newrecords == NULL )
+            {
+               seterror(reader, "Out of memory.", NULL);
+               goto TERMINATE;
+            }
+            records = newrecords;
+         }
+         records[nrecords++] = (uint32_t)index->i;
+
+         if( skipvalue(index) != RETURN_OK )
+            goto TERMINATE;
+         if( currentchar(index) == ']' )
+            break;
+         if( currentchar(index) != ',' )
+            goto TERMINATE;
+         ++index->i;
+      }
+   ++index->i;
+
+   nthreads = reader->nthreads;
+   if( nthreads > nrecords / MINSLICEVARS )
+      nthreads = nrecords / MINSLICEVARS;
+   if( nthreads < 1 )
+      nthreads = 1;
+
+   varidx = (int*) malloc((nrecords + 1) * sizeof(int));
+   values = (double*) malloc((nrecords + 1) * sizeof(double));
+   slices = (varslice_t*) calloc(nthreads, sizeof(varslice_t));
+   if( varidx == NULL || values == NULL || slices == NULL )
+   {
+      seterror(reader, "Out of memory.", NULL);
+      goto TERMINATE;
+   }
+
+   for( t = 0; t < nthreads; ++t )
+   {
+      slices[t].reader = reader;
+      slices[t].index = index;
+      slices[t].records = records;
+      slices[t].begin = (int)((double)nrecords * t / nthreads);
+      slices[t].end = (int)((double)nrecords * (t+1) / nthreads);
+      slices[t].varidx = varidx;
+      slices[t].values = values;
+   }
+
+   /* the first slice is converted by the calling thread, as is any slice for which no thread could be started,
+    * and all slices on Windows, where there are no POSIX threads
+    */
+#ifndef _WIN32
+   for( t = 1; t < nthreads; ++t )
+      slices[t].threaded = (pthread_create(&slices[t].thread, NULL, convertslice, &slices[t]) == 0);
+#endif
+   convertslice(&slices[0]);
+   for( t = 1; t < nthreads; ++t )
+#ifndef _WIN32
+      if( slices[t].threaded )
+         pthread_join(slices[t].thread, NULL);
+      else
+#endif
+         convertslice(&slices[t]);
+
+   /* report the error that comes first in the document, as a sequential walk would */
+   for( t = 0; t < nthreads; ++t )
+      if( slices[t].failed )
+      {
+         if( *slices[t].error != '\0' )
+            seterror(reader, slices[t].error, NULL);
+         goto TERMINATE;
+      }
+
+   for( k = 0; k < nrecords; ++k )
+      reader->levels[varidx[k]] = values[k];
+   reader->nvars = nrecords;
+
+   rc = RETURN_OK;
+
+TERMINATE:
+   free(slices);
+   free(values);
+   free(varidx);
+   free(records);
+
+   return rc;
+}
+
+/** visits the array of variables at the current position and stores their values */
+static
+RETURN walkvariables(
+   solreader_t* reader,
+   jsonindex_t* index
+)
+{
+   if( reader->nthreads > 1 )
+      return walkvariablesparallel(reader, index);
+
+   assert(currentchar(index) == '[');
+   ++index->i;
+
+   reader->nvars = 0;
+   if( currentchar(index) == ']' )
+   {
+      ++index->i;
+      return RETURN_OK;
+   }
+
+   for( ;; )
+   {
+      if( currentchar(index) != '{' )
+         return RETURN_ERROR;
+
+      reader->varidx = -1;
+      reader->hasvalue = 0;
+      if( walkobject(reader, index, ROLE_VARIABLE) != RETURN_OK )
+         return RETURN_ERROR;
+      if( storevariable(reader) != RETURN_OK )
+         return RETURN_ERROR;
+
+      switch( currentchar(index) )
+      {
+         case ',' :
+            ++index->i;
+            break;
+         case ']' :
+            ++index->i;
+            return RETURN_OK;
+         default :
+            return RETURN_ERROR;
+      }
+   }
+}
+
+/** visits the object at the current position and the members that are of interest */
+static
+RETURN walkobject(
+   solreader_t* reader,
+   jsonindex_t* index,
+   ROLE         role
+)
+{
+   assert(currentchar(index) == '{');
+   ++index->i;
+
+   if( currentchar(index) == '}' )
+   {
+      ++index->i;
+      return RETURN_OK;
+   }
+
+   for( ;; )
+   {
+      KEY key;
+      char c;
+
+      if( currentchar(index) != '"' )
+         return RETURN_ERROR;
+      readstring(reader, index);
+      key = identifykey(role, reader->token);
+
+      if( currentchar(index) != ':' )
+         return RETURN_ERROR;
+      ++index->i;
+
+      c = currentchar(index);
+      if( key == KEY_RESULT && c == '{' )
+      {
+         if( walkobject(reader, index, ROLE_RESULT) != RETURN_OK )
+            return RETURN_ERROR;
+      }
+      else if( key == KEY_VARIABLES && c == '[' )
+      {
+         if( walkvariables(reader, index) != RETURN_OK )
+            return RETURN_ERROR;
+      }
+      else if( key == KEY_STATUS && c == '"' )
+      {
+         readstring(reader, index);
+         strcpy(reader->status, reader->token);
+         reader->hasstatus = 1;
+      }
+      else if( key == KEY_OBJVAL && c != '"' && c != '{' && c != '[' && c != '\0' )
+      {
+         reader->hasobjval = readnumber(index, &reader->objval);
+      }
+      else if( key == KEY_NAME && c == '"' )
+      {
+         readstring(reader, index);
+         reader->varidx = convertParseVarIdx(reader->token);
+         if( reader->varidx < 0 || reader->varidx >= reader->nlevels )
+         {
+            seterror(reader, "Error parsing variable result", reader->token);
+            return RETURN_ERROR;
+         }
+      }
+      else if( key == KEY_VALUE && c != '"' && c != '{' && c != '[' && c != '\0' )
+      {
+         reader->hasvalue = readnumber(index, &reader->varvalue);
+      }
+      else
+      {
+         if( skipvalue(index) != RETURN_OK )
+            return RETURN_ERROR;
+      }
+
+      switch( currentchar(index) )
+      {
+         case ',' :
+            ++index->i;
+            break;
+         case '}' :
+            ++index->i;
+            return RETURN_OK;
+         default :
+            return RETURN_ERROR;
+      }
+   }
+}
+
+RETURN solreaderReadIndexed(
+   solreader_t* reader,
+   const char*  json,
+   size_t       length
+)
+{
+   jsonindex_t index;
+   RETURN rc = RETURN_ERROR;
+
+   assert(reader != NULL);
+   assert(json != NULL);
+
+   solreaderReset(reader);
+   reader->length = length;
+
+   memset(&index, 0, sizeof(index));
+   index.json = json;
+   index.length = length;
+
+   if( buildindex(&index) != RETURN_OK )
+   {
+      seterror(reader, "Results are not valid JSON.", NULL);
+      goto TERMINATE;
+   }
+
+   if( currentchar(&index) != '{' )
+   {
+      seterror(reader, "Results are not a JSON object.", NULL);
+      goto TERMINATE;
+   }
+
+   if( walkobject(reader, &index, ROLE_ROOT) != RETURN_OK || index.i != index.npos )
+   {
+      seterror(reader, "Results are not valid JSON.", NULL);
+      goto TERMINATE;
+   }
+
+   /* let solreaderFinish() succeed */
+   reader->expect = EXPECT_END;
+   rc = RETURN_OK;
+
+TERMINATE:
+   free(index.pos);
+
+   return rc;
+}
+
+size_t solreaderWriteCurl(
+   char*  ptr,
+   size_t size,
+   size_t nmemb,
+   void*  userdata
+)
+{
+   solreader_t* reader = (solreader_t*) userdata;
+   size_t length = size * nmemb;
+
+   assert(reader != NULL);
+
+   /* keep the beginning of the response, e.g., for error messages */
+   if( reader->headlen < HEADSIZE-1 )
+   {
+      size_t n = length < HEADSIZE-1 - reader->headlen ? length : HEADSIZE-1 - reader->headlen;
+      memcpy(reader->head + reader->headlen, ptr, n);
+      reader->headlen += n;
+      reader->head[reader->headlen] = '\0';
+   }
+
+   reader->length += length;
+   processdata(reader, ptr, length);
+
+   return length;
+}
+
+RETURN solreaderFinish(
+   solreader_t* reader
+)
+{
+   assert(reader != NULL);
+
+   if( reader->lex == LEX_ERROR )
+      return RETURN_ERROR;
+
+   if( reader->lex != LEX_BETWEEN || reader->expect != EXPECT_END )
+   {
+      seterror(reader, "Results are incomplete.", NULL);
+      return RETURN_ERROR;
+   }
+
+   return RETURN_OK;
+}
+
+const char* solreaderGetError(
+   solreader_t* reader
+)
+{
+   assert(reader != NULL);
+
+   return reader->error;
+}
+
+const char* solreaderGetHead(
+   solreader_t* reader,
+   size_t*      length
+)
+{
+   assert(reader != NULL);
+
+   if( length != NULL )
+      *length = reader->headlen;
+
+   return reader->head;
+}
+
+void solreaderSetThreads(
+   solreader_t* reader,
+   int          nthreads
+)
+{
+   assert(reader != NULL);
+
+   reader->nthreads = nthreads;
+}
+
+size_t solreaderGetLength(
+   solreader_t* reader
+)
+{
+   assert(reader != NULL);
+
+   return reader->length;
+}
+
+const char* solreaderGetStatus(
+   solreader_t* reader
+)
+{
+   assert(reader != NULL);
+
+   return reader->hasstatus ? reader->status : NULL;
+}
+
+int solreaderGetObjective(
+   solreader_t* reader,
+   double*      objval
+)
+{
+   assert(reader != NULL);
+   assert(objval != NULL);
+
+   if( reader->hasobjval )
+      *objval = reader->objval;
+
+   return reader->hasobjval;
+}
+
+int solreaderGetNVars(
+   solreader_t* reader
+)
+{
+   assert(reader != NULL);
+
+   return reader->nvars;
+}
+
+const double* solreaderGetLevels(
+   solreader_t* reader
+)
+{
+   assert(reader != NULL);
+
+   return reader->levels;
+}
@@ -0,0 +1,120 @@
+#ifndef SOLREADER_H_
+#define SOLREADER_H_
+
+#include <stddef.h>
+
+#include "convert.h"  /* for RETURN */
+
+/** streaming reader for the results of a SolveEngine job
+ *
+ * The response of the results request is parsed while it is downloaded.
+ * Status, objective value, and the value of each variable are stored as soon as they arrive,
+ * so no tree of the whole response is built and memory does not grow with the number of variables,
+ * apart from the preallocated vector of variable levels.
+ */
+typedef struct solreader_s solreader_t;
+
+extern
+RETURN solreaderCreate(
+   solreader_t** reader,
+   int           nvars       /**< number of variables in GAMS instance */
+);
+
+extern
+void solreaderFree(
+   solreader_t** reader
+);
+
+/** prepares the reader for a new response */
+extern
+void solreaderReset(
+   solreader_t* reader
+);
+
+/** curl write callback that feeds a piece of the response into the reader
+ *
+ * Data after a parse error is ignored, so that the transfer itself still completes.
+ */
+extern
+size_t solreaderWriteCurl(
+   char*  ptr,
+   size_t size,
+   size_t nmemb,
+   void*  userdata
+);
+
+/** checks that the complete response has been parsed without error */
+extern
+RETURN solreaderFinish(
+   solreader_t* reader
+);
+
+/** reads complete results from a buffer via a structural index, as an alternative to feeding them piece by piece
+ *
+ * A first pass over blocks of 64 characters (using SSE2, if available) finds the positions of all structural characters
+ * and of the beginnings of strings and scalars. Then only the members of the document that are needed are visited.
+ * No call of solreaderFinish() is needed afterwards.
+ */
+extern
+RETURN solreaderReadIndexed(
+   solreader_t* reader,
+   const char*  json,
+   size_t       length
+);
+
+/** sets the number of threads that convert names and values of variables in solreaderReadIndexed()
+ *
+ * With more than one thread, the variables are split into slices that are converted in parallel.
+ * The levels are the same as with a single thread.
+ */
+extern
+void solreaderSetThreads(
+   solreader_t* reader,
+   int          nthreads
+);
+
+/** gives message of parse error, or empty string */
+extern
+const char* solreaderGetError(
+   solreader_t* reader
+);
+
+/** gives the beginning of the response, for error messages */
+extern
+const char* solreaderGetHead(
+   solreader_t* reader,
+   size_t*      length
+);
+
+/** gives the number of bytes of the response that have been fed into the reader */
+extern
+size_t solreaderGetLength(
+   solreader_t* reader
+);
+
+/** gives the status of the results, or NULL if not in response */
+extern
+const char* solreaderGetStatus(
+   solreader_t* reader
+);
+
+/** gives whether the response had an objective value and stores it */
+extern
+int solreaderGetObjective(
+   solreader_t* reader,
+   double*      objval
+);
+
+/** gives the number of variables in the response, or -1 if there were no variables */
+extern
+int solreaderGetNVars(
+   solreader_t* reader
+);
+
+/** gives the levels of the variables, indexed as in the GAMS instance */
+extern
+const double* solreaderGetLevels(
+   solreader_t* reader
+);
+
+#endif /* SOLREADER_H_ */
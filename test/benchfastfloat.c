@@ -0,0 +1,130 @@
+/** benchmark of parsing numbers
+ *
+ * Generates numbers as they appear in results of SolveEngine: integer values of discrete variables,
+ * and values of continuous variables with up to 17 significant digits.
+ * Times fastfloatParse() and strtod() on each number, and cJSON_Parse() on a document with all numbers.
+ *
+ * usage: benchfastfloat [nnumbers]
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "cJSON.h"
+#include "fastfloat.h"
+
+/** gives the time in seconds since some fixed point */
+static
+double now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/** prints time and throughput of a parser */
+static
+void report(
+   const char* name,
+   double      time,
+   int         n,
+   size_t      length
+)
+{
+   printf("  %-14s %8.3f s %9.1f M numbers/s %9.1f MB/s\n", name, time, n / time / 1e6, length / time / (1024.0 * 1024.0));
+}
+
+int main(
+   int    argc,
+   char** argv
+)
+{
+   int n = argc > 1 ? atoi(argv[1]) : 10000000;
+   char* json;
+   size_t* starts;
+   size_t length;
+   double sum1 = 0.0;
+   double sum2 = 0.0;
+   double start;
+   cJSON* root;
+   int i;
+
+   /* each number takes at most 25 characters plus separator */
+   json = (char*) malloc((size_t)n * 26 + 3);
+   starts = (size_t*) malloc((size_t)n * sizeof(size_t));
+   if( json == NULL || starts == NULL )
+   {
+      fprintf(stderr, "Out of memory for %d numbers.\n", n);
+      return EXIT_FAILURE;
+   }
+
+   srand(42);
+   length = 0;
+   json[length++] = '[';
+   for( i = 0; i < n; ++i )
+   {
+      if( i > 0 )
+         json[length++] = ',';
+      starts[i] = length;
+
+      switch( i % 4 )
+      {
+         case 0 :
+            length += (size_t)sprintf(json + length, "%d", rand() % 1000);
+            break;
+         case 1 :
+            length += (size_t)sprintf(json + length, "%.17g", (rand() - RAND_MAX / 2) / 1024.0 / (1 + rand() % 1000));
+            break;
+         case 2 :
+            length += (size_t)sprintf(json + length, "%.15g", rand() / 3.0);
+            break;
+         default :
+            length += (size_t)sprintf(json + length, "%.17g", rand() * 1e-9);
+            break;
+      }
+   }
+   json[length++] = ']';
+   json[length] = '\0';
+
+   printf("%d numbers, %.1f MB:\n", n, length / (1024.0 * 1024.0));
+
+   start = now();
+   for( i = 0; i < n; ++i )
+      sum1 += strtod(json + starts[i], NULL);
+   report("strtod", now() - start, n, length);
+
+   start = now();
+   for( i = 0; i < n; ++i )
+   {
+      double value;
+
+      fastfloatParse(json + starts[i], length - starts[i], &value);
+      sum2 += value;
+   }
+   report("fastfloatParse", now() - start, n, length);
+
+   if( sum1 != sum2 )
+   {
+      printf("Sums of numbers differ: %.17g vs %.17g\n", sum1, sum2);
+      return EXIT_FAILURE;
+   }
+
+   start = now();
+   root = cJSON_Parse(json);
+   if( root == NULL )
+   {
+      fprintf(stderr, "Error parsing document.\n");
+      return EXIT_FAILURE;
+   }
+   report("cJSON_Parse", now() - start, n, length);
+
+   cJSON_Delete(root);
+   free(starts);
+   free(json);
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/** benchmark of looking up the members of the jobs in a job list
+ *
+ * Generates pages of a job list as SolveEngine gives them, where each job has the seven members
+ * that printjoblist() looks up, preceded by a given number of further members.
+ * Times the lookups of printjoblist() with a linear search, as cJSON did before objects got a hash index,
+ * with cJSON_GetObjectItem(), which builds the index of wide objects on the first lookup,
+ * and with cJSON_GetObjectItem() after indexing every job with cJSON_IndexObject().
+ *
+ * usage: benchjoblist [njobs [width ...]]
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "cJSON.h"
+
+#define NPASSES 10           /**< number of times all jobs are looked up */
+
+/** members of a job that printjoblist() looks up */
+static const char* keys[] = { "id", "status", "algorithm", "submitted", "started", "finished", "used_time" };
+#define NKEYS ((int)(sizeof(keys) / sizeof(*keys)))
+
+/** gives the time in seconds since some fixed point */
+static
+double now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/** generates a page of a job list with njobs jobs that have nextra further members each */
+static
+char* generatejoblist(
+   int njobs,
+   int nextra
+)
+{
+   char* json;
+   size_t len;
+   int i;
+   int k;
+
+   json = (char*) malloc((size_t)njobs * (256 + 32 * (size_t)nextra) + 64);
+   if( json == NULL )
+      return NULL;
+
+   len = (size_t)sprintf(json, "{\"total\":%d,\"jobs\":[", njobs);
+   for( i = 0; i < njobs; ++i )
+   {
+      len += (size_t)sprintf(json + len, "%s{", i > 0 ? "," : "");
+      for( k = 0; k < nextra; ++k )
+         len += (size_t)sprintf(json + len, "\"extra_%d\":%d,", k, k);
+      len += (size_t)sprintf(json + len,
+         "\"id\":\"job-%08d\",\"algorithm\":\"LP\",\"status\":\"%s\",\"submitted\":\"2017-06-20T10:25:10Z\","
+         "\"started\":\"2017-06-20T10:25:11Z\",\"finished\":\"2017-06-20T10:25:12Z\",\"used_time\":%d}",
+         i, i % 3 ? "completed" : "failed", i % 100);
+   }
+   sprintf(json + len, "]}");
+
+   return json;
+}
+
+/** looks up a member by a case insensitive linear search, as cJSON_GetObjectItem() did before objects got a hash index */
+static
+cJSON* getlinear(
+   const cJSON* object,
+   const char*  name
+)
+{
+   cJSON* item;
+
+   for( item = object->child; item != NULL; item = item->next )
+      if( item->string != NULL && strcasecmp(item->string, name) == 0 )
+         return item;
+
+   return NULL;
+}
+
+/** looks up the members of all jobs as printjoblist() does, gives the time per pass */
+static
+double lookup(
+   const cJSON* jobs,
+   int          linear,
+   long*        nfound
+)
+{
+   const cJSON* job;
+   double start;
+   int pass;
+   int k;
+
+   start = now();
+   for( pass = 0; pass < NPASSES; ++pass )
+      cJSON_ArrayForEach(job, jobs)
+         for( k = 0; k < NKEYS; ++k )
+            if( (linear ? getlinear(job, keys[k]) : cJSON_GetObjectItem(job, keys[k])) != NULL )
+               ++*nfound;
+
+   return (now() - start) / NPASSES;
+}
+
+int main(
+   int    argc,
+   char** argv
+)
+{
+   int defaultwidths[] = { 0, 16, 64, 256 };
+   int njobs = argc > 1 ? atoi(argv[1]) : 100000;
+   int nwidths = argc > 2 ? argc - 2 : (int)(sizeof(defaultwidths) / sizeof(*defaultwidths));
+   int w;
+
+   printf("%d jobs, %d lookups per job, times per pass over all jobs:\n", njobs, NKEYS);
+   printf("  %6s %10s %10s %10s %10s\n", "width", "parse", "linear", "lazy", "indexed");
+
+   for( w = 0; w < nwidths; ++w )
+   {
+      int nextra = argc > 2 ? atoi(argv[w+2]) : defaultwidths[w];
+      double tparse;
+      double tlinear;
+      double tlazy;
+      double tindexed;
+      long nfound = 0;
+      cJSON* root;
+      cJSON* jobs;
+      cJSON* job;
+      char* json;
+      double start;
+
+      json = generatejoblist(njobs, nextra);
+      if( json == NULL )
+      {
+         fprintf(stderr, "Out of memory for %d jobs.\n", njobs);
+         return EXIT_FAILURE;
+      }
+
+      start = now();
+      root = cJSON_Parse(json);
+      tparse = now() - start;
+      jobs = cJSON_GetObjectItem(root, "jobs");
+      if( jobs == NULL || !cJSON_IsArray(jobs) )
+      {
+         fprintf(stderr, "Error parsing job list.\n");
+         return EXIT_FAILURE;
+      }
+
+      tlinear = lookup(jobs, 1, &nfound);
+
+      /* the first pass builds the index of wide jobs */
+      tlazy = lookup(jobs, 0, &nfound);
+
+      cJSON_ArrayForEach(job, jobs)
+         cJSON_IndexObject(job);
+      tindexed = lookup(jobs, 0, &nfound);
+
+      if( nfound != 3L * NPASSES * NKEYS * njobs )
+      {
+         fprintf(stderr, "Not all members found.\n");
+         return EXIT_FAILURE;
+      }
+
+      printf("  %6d %9.3fs %9.3fs %9.3fs %9.3fs\n", NKEYS + nextra, tparse, tlinear, tlazy, tindexed);
+
+      cJSON_Delete(root);
+      free(json);
+   }
+
+   return EXIT_SUCCESS;
+}
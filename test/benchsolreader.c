@@ -0,0 +1,252 @@
+/** benchmark of reading the results of a job
+ *
+ * Generates results of SolveEngine with a given number of variables and reads them
+ * - via cJSON, as getsolution() does with parsed results,
+ * - via the streaming reader, fed in pieces as curl delivers them, and
+ * - via the structural index of the streaming reader, with one and with several threads.
+ * All ways must give the same levels.
+ *
+ * usage: benchsolreader [-t nthreads] [nvars ...]
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "cJSON.h"
+#include "convert.h"
+#include "solreader.h"
+
+#define PIECESIZE 16384      /**< size of pieces in which curl delivers a download */
+
+/** gives the time in seconds since some fixed point */
+static
+double now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/** generates results with n variables in the form that SolveEngine gives them */
+static
+char* generateresults(
+   int     n,
+   size_t* length
+)
+{
+   char* json;
+   size_t size;
+   size_t len;
+   int i;
+
+   /* each variable takes at most 16 characters for the name and 26 for the value, plus the punctuation */
+   size = (size_t)n * 64 + 256;
+   json = (char*) malloc(size);
+   if( json == NULL )
+      return NULL;
+
+   srand(42);
+   len = (size_t)sprintf(json, "{\"result\":{\"status\":\"optimal\",\"objective_value\":%.17g,\"variables\":[", 12345.678);
+   for( i = 0; i < n; ++i )
+   {
+      double value;
+
+      /* integer values, as of discrete variables, and values with many digits */
+      if( i % 3 == 0 )
+         value = rand() % 100;
+      else
+         value = (rand() - RAND_MAX / 2) / 1024.0 / (1 + rand() % 1000);
+
+      len += (size_t)sprintf(json + len, "%s{\"name\":\"%c%d\",\"value\":%.17g}", i > 0 ? "," : "", i % 2 ? 'i' : 'x', i, value);
+   }
+   len += (size_t)sprintf(json + len, "]},\"job_id\":\"bench\"}");
+
+   *length = len;
+
+   return json;
+}
+
+/** reads levels via cJSON, as getsolution() does */
+static
+RETURN readcjson(
+   const char* json,
+   int         n,
+   double*     levels
+)
+{
+   cJSON* root;
+   cJSON* variables;
+   cJSON* var;
+   RETURN rc = RETURN_ERROR;
+
+   root = cJSON_Parse(json);
+   if( root == NULL )
+      return RETURN_ERROR;
+
+   variables = cJSON_GetObjectItem(cJSON_GetObjectItem(root, "result"), "variables");
+   if( variables == NULL || !cJSON_IsArray(variables) )
+      goto TERMINATE;
+
+   cJSON_ArrayForEach(var, variables)
+   {
+      cJSON* name = cJSON_GetObjectItem(var, "name");
+      cJSON* value = cJSON_GetObjectItem(var, "value");
+      int idx;
+
+      if( name == NULL || !cJSON_IsString(name) || value == NULL || !cJSON_IsNumber(value) )
+         goto TERMINATE;
+
+      idx = convertParseVarIdx(name->valuestring);
+      if( idx < 0 || idx >= n )
+         goto TERMINATE;
+
+      levels[idx] = value->valuedouble;
+   }
+
+   rc = RETURN_OK;
+
+TERMINATE:
+   cJSON_Delete(root);
+
+   return rc;
+}
+
+/** reads levels via the streaming reader, fed piece by piece */
+static
+RETURN readstream(
+   solreader_t* reader,
+   const char*  json,
+   size_t       length
+)
+{
+   size_t pos;
+
+   solreaderReset(reader);
+   for( pos = 0; pos < length; pos += PIECESIZE )
+   {
+      size_t piece = length - pos < PIECESIZE ? length - pos : PIECESIZE;
+
+      /* copy, as curl does into its receive buffer */
+      char buffer[PIECESIZE];
+      memcpy(buffer, json + pos, piece);
+
+      if( solreaderWriteCurl(buffer, 1, piece, reader) != piece )
+         return RETURN_ERROR;
+   }
+
+   return solreaderFinish(reader);
+}
+
+/** prints time and throughput of a way to read results, and checks its levels against the expected ones */
+static
+int report(
+   const char*   name,
+   double        time,
+   size_t        length,
+   const double* levels,
+   const double* expected,
+   int           n
+)
+{
+   int ok = expected == NULL || memcmp(levels, expected, n * sizeof(double)) == 0;
+
+   printf("  %-20s %9.3f s %9.1f MB/s %s\n", name, time, length / time / (1024.0 * 1024.0), ok ? "" : "DIFFERENT LEVELS");
+
+   return ok;
+}
+
+int main(
+   int    argc,
+   char** argv
+)
+{
+   int nthreads = 4;
+   int defaultsizes[] = { 1000000, 10000000 };
+   int nsizes;
+   int* sizes;
+   int ok = 1;
+   int s;
+
+   if( argc > 2 && strcmp(argv[1], "-t") == 0 )
+   {
+      nthreads = atoi(argv[2]);
+      argc -= 2;
+      argv += 2;
+   }
+
+   nsizes = argc > 1 ? argc - 1 : 2;
+   sizes = (int*) malloc(nsizes * sizeof(int));
+   for( s = 0; s < nsizes; ++s )
+      sizes[s] = argc > 1 ? atoi(argv[s+1]) : defaultsizes[s];
+
+   for( s = 0; s < nsizes; ++s )
+   {
+      solreader_t* reader = NULL;
+      double* cjsonlevels;
+      char* json;
+      char name[32];
+      size_t length;
+      double start;
+      int n = sizes[s];
+
+      json = generateresults(n, &length);
+      cjsonlevels = (double*) calloc(n, sizeof(double));
+      if( json == NULL || cjsonlevels == NULL || solreaderCreate(&reader, n) != RETURN_OK )
+      {
+         fprintf(stderr, "Out of memory for %d variables.\n", n);
+         return EXIT_FAILURE;
+      }
+
+      printf("%d variables, %.1f MB of results:\n", n, length / (1024.0 * 1024.0));
+
+      start = now();
+      if( readcjson(json, n, cjsonlevels) != RETURN_OK )
+      {
+         fprintf(stderr, "Error reading results via cJSON.\n");
+         return EXIT_FAILURE;
+      }
+      ok &= report("cJSON", now() - start, length, cjsonlevels, NULL, n);
+
+      start = now();
+      if( readstream(reader, json, length) != RETURN_OK )
+      {
+         fprintf(stderr, "Error reading results via streaming: %s\n", solreaderGetError(reader));
+         return EXIT_FAILURE;
+      }
+      ok &= report("streaming", now() - start, length, solreaderGetLevels(reader), cjsonlevels, n);
+
+      solreaderSetThreads(reader, 1);
+      start = now();
+      if( solreaderReadIndexed(reader, json, length) != RETURN_OK )
+      {
+         fprintf(stderr, "Error reading results via index: %s\n", solreaderGetError(reader));
+         return EXIT_FAILURE;
+      }
+      ok &= report("indexed", now() - start, length, solreaderGetLevels(reader), cjsonlevels, n);
+
+      if( nthreads > 1 )
+      {
+         solreaderSetThreads(reader, nthreads);
+         start = now();
+         if( solreaderReadIndexed(reader, json, length) != RETURN_OK )
+         {
+            fprintf(stderr, "Error reading results via index: %s\n", solreaderGetError(reader));
+            return EXIT_FAILURE;
+         }
+         sprintf(name, "indexed, %d threads", nthreads);
+         ok &= report(name, now() - start, length, solreaderGetLevels(reader), cjsonlevels, n);
+      }
+
+      solreaderFree(&reader);
+      free(cjsonlevels);
+      free(json);
+   }
+
+   free(sizes);
+
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
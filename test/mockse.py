@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""Mock of the SolveEngine API for testing gamsse without an account.
+
+Serves the requests that gamsse sends on http://127.0.0.1:<port>/api/v2, so run gamsse with the options
+    apiurl http://127.0.0.1:8765/api/v2
+    apiextensions 1
+Jobs are not solved: each job is queued on the first status request, running on the second, and
+completed afterwards, and its results give every variable of the .lp file the value 0.5 * index.
+
+In addition to the SolveEngine API, the mock implements resumable uploads:
+    POST /uploads {"length": n}          opens an upload session, gives {"id": session}
+    PUT /uploads/<session>               stores a chunk, with header Content-Range: bytes first-last/n
+    POST /uploads/<session>/commit       creates a job from the uploaded bytes once all have arrived
+
+and a submitted problem that refers to an earlier one:
+    "problem_key": key                   in a submit request keeps its problem under key
+    "base": key, "delta": changes        in a submit request, instead of the .lp file as first problem,
+                                         gives the problem kept under key with changes of bounds,
+                                         right-hand sides, and objective, see modeldeltaWriteJSON()
+A base that is not known is answered with 409 Conflict, as after a restart of the mock.
+
+Transient failures can be injected with the --fail-* arguments, which answer the given number of
+requests of a kind with 503 Service Unavailable, so that retries and resumed uploads can be tested.
+"""
+
+import argparse
+import base64
+import json
+import re
+import sys
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+PREFIX = '/api/v2'
+
+lock = threading.Lock()
+jobs = {}
+uploads = {}
+problems = {}
+counter = [0]
+failures = {}
+
+
+def newid(kind):
+    with lock:
+        counter[0] += 1
+        return '%s-%d' % (kind, counter[0])
+
+
+def fail(kind):
+    """whether to answer the current request of a kind with a transient failure"""
+    with lock:
+        if failures.get(kind, 0) > 0:
+            failures[kind] -= 1
+            return True
+    return False
+
+
+def log(msg):
+    sys.stderr.write('mockse: %s\n' % msg)
+
+
+def createjob(body):
+    """creates a job from the body of a submit request, gives its id or None if its base is not known"""
+    request = json.loads(body)
+    if 'base' in request:
+        # the mock does not solve, so the changes need not be applied, as the variables stay the same
+        if request['base'] not in problems:
+            log('unknown base %s' % request['base'])
+            return None
+        names = problems[request['base']]
+        nchanges = sum(len(changes) for key, changes in request['delta'].items() if key != 'objconst')
+        log('%d changes against %s' % (nchanges, request['base']))
+    else:
+        lp = base64.b64decode(request['problems'][0]['data']).decode()
+        names = sorted(set(re.findall(r'\b[xbijy]\d+\b', lp)), key=lambda name: int(name[1:]))
+    if 'problem_key' in request:
+        problems[request['problem_key']] = names
+    jobid = newid('job')
+    jobs[jobid] = {'names': names, 'polls': 0, 'stopped': False}
+    log('created %s with %d variables from %d bytes' % (jobid, len(names), len(body)))
+    return jobid
+
+
+def replycreated(handler, jobid):
+    if jobid is None:
+        return handler.reply(409, {'error': 'unknown base problem'})
+    return handler.reply(200, {'id': jobid})
+
+
+class Handler(BaseHTTPRequestHandler):
+    # keep connections open, as gamsse reuses them
+    protocol_version = 'HTTP/1.1'
+
+    def log_message(self, fmt, *args):
+        if self.server.verbose:
+            log('%s %s' % (self.command, self.path))
+
+    def reply(self, code, obj=None):
+        body = json.dumps(obj).encode() if obj is not None else b''
+        self.send_response(code)
+        self.send_header('Content-Type', 'application/json')
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def body(self):
+        length = int(self.headers.get('Content-Length', 0))
+        return self.rfile.read(length) if length > 0 else b''
+
+    def route(self):
+        path = self.path.split('?')[0]
+        if not path.startswith(PREFIX):
+            return None
+        return path[len(PREFIX):]
+
+    def do_POST(self):
+        body = self.body()
+        path = self.route()
+
+        if path == '/jobs':
+            if fail('submit'):
+                return self.reply(503, {'error': 'unavailable'})
+            return replycreated(self, createjob(body))
+
+        if path == '/uploads':
+            length = json.loads(body)['length']
+            session = newid('upload')
+            uploads[session] = {'data': bytearray(length), 'received': [False] * length, 'chunks': 0}
+            log('opened %s for %d bytes' % (session, length))
+            return self.reply(200, {'id': session})
+
+        m = re.match(r'/uploads/([^/]+)/commit$', path or '')
+        if m and m.group(1) in uploads:
+            upload = uploads[m.group(1)]
+            missing = upload['received'].count(False)
+            if missing > 0:
+                return self.reply(400, {'error': '%d bytes missing' % missing})
+            log('committed %s after %d chunks' % (m.group(1), upload['chunks']))
+            return replycreated(self, createjob(bytes(upload['data'])))
+
+        m = re.match(r'/jobs/([^/]+)/schedule$', path or '')
+        if m and m.group(1) in jobs:
+            return self.reply(200)
+
+        self.reply(404, {'error': 'not found'})
+
+    def do_PUT(self):
+        body = self.body()
+        path = self.route()
+
+        m = re.match(r'/uploads/([^/]+)$', path or '')
+        if m and m.group(1) in uploads:
+            if fail('chunk'):
+                return self.reply(503, {'error': 'unavailable'})
+            upload = uploads[m.group(1)]
+            r = re.match(r'bytes (\d+)-(\d+)/(\d+)$', self.headers.get('Content-Range', ''))
+            if r is None or int(r.group(2)) - int(r.group(1)) + 1 != len(body) or int(r.group(3)) != len(upload['data']):
+                return self.reply(400, {'error': 'bad content range'})
+            first, last = int(r.group(1)), int(r.group(2))
+            upload['data'][first:last+1] = body
+            upload['received'][first:last+1] = [True] * len(body)
+            upload['chunks'] += 1
+            return self.reply(200, {'received': len(body)})
+
+        self.reply(404, {'error': 'not found'})
+
+    def do_GET(self):
+        path = self.route()
+
+        if path == '/jobs':
+            query = dict(p.split('=', 1) for p in self.path.partition('?')[2].split('&') if '=' in p)
+            page = int(query.get('page', 1))
+            perpage = int(query.get('per_page', 10))
+            joblist = [{'id': 'listed-%06d' % i, 'algorithm': 'LP', 'status': 'failed' if i % 3 == 0 else 'completed',
+                        'submitted': '2017-06-20T10:25:10Z', 'started': '2017-06-20T10:25:11Z',
+                        'finished': '2017-06-20T10:25:12Z', 'used_time': i % 100}
+                       for i in range((page - 1) * perpage, min(page * perpage, self.server.njobs))]
+            return self.reply(200, {'total': self.server.njobs, 'jobs': joblist})
+
+        m = re.match(r'/jobs/([^/]+)/status$', path or '')
+        if m and m.group(1) in jobs:
+            if fail('status'):
+                return self.reply(503, {'error': 'unavailable'})
+            job = jobs[m.group(1)]
+            job['polls'] += 1
+            if job['stopped']:
+                status = 'stopped'
+            elif job['polls'] < 2:
+                status = 'queued'
+            elif job['polls'] < 3:
+                status = 'started'
+            else:
+                status = 'completed'
+            return self.reply(200, {'status': status})
+
+        m = re.match(r'/jobs/([^/]+)/results$', path or '')
+        if m and m.group(1) in jobs:
+            if fail('results'):
+                return self.reply(503, {'error': 'unavailable'})
+            variables = [{'name': name, 'value': int(name[1:]) * 0.5} for name in jobs[m.group(1)]['names']]
+            return self.reply(200, {'result': {'status': 'optimal',
+                                               'objective_value': sum(v['value'] for v in variables),
+                                               'variables': variables}})
+
+        self.reply(404, {'error': 'not found'})
+
+    def do_DELETE(self):
+        self.body()
+        path = self.route()
+
+        m = re.match(r'/jobs/([^/]+)/stop$', path or '')
+        if m and m.group(1) in jobs:
+            jobs[m.group(1)]['stopped'] = True
+            return self.reply(200)
+
+        m = re.match(r'/jobs/([^/]+)$', path or '')
+        if m and m.group(1) in jobs:
+            del jobs[m.group(1)]
+            return self.reply(200)
+
+        self.reply(404, {'error': 'not found'})
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Mock of the SolveEngine API for testing gamsse.')
+    parser.add_argument('--port', type=int, default=8765)
+    parser.add_argument('--fail-submit', type=int, default=0, metavar='N', help='fail the first N submit requests')
+    parser.add_argument('--fail-chunk', type=int, default=0, metavar='N', help='fail the first N chunk uploads')
+    parser.add_argument('--fail-status', type=int, default=0, metavar='N', help='fail the first N status requests')
+    parser.add_argument('--fail-results', type=int, default=0, metavar='N', help='fail the first N results requests')
+    parser.add_argument('--jobs', type=int, default=25, metavar='N', help='number of jobs in the job list')
+    parser.add_argument('--verbose', action='store_true', help='log every request')
+    args = parser.parse_args()
+
+    failures.update({'submit': args.fail_submit, 'chunk': args.fail_chunk,
+                     'status': args.fail_status, 'results': args.fail_results})
+
+    server = ThreadingHTTPServer(('127.0.0.1', args.port), Handler)
+    server.verbose = args.verbose
+    server.njobs = args.jobs
+    log('listening on http://127.0.0.1:%d%s' % (args.port, PREFIX))
+    server.serve_forever()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,160 @@
+/** test that fastfloatParse() gives the same values as strtod()
+ *
+ * Compares the value and the number of characters read for random numbers in the formats that
+ * SolveEngine and printf() write, for random decimal strings with up to 25 digits, and for some
+ * hard cases close to the limits of double. Hexadecimal numbers, inf, and nan are not compared,
+ * as they are no JSON numbers and fastfloatParse() does not read them.
+ *
+ * usage: testfastfloat [ncases [seed]]
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "fastfloat.h"
+
+/** hard cases: exact halfway points, limits of double and of the fast path, long mantissas */
+static const char* hardcases[] =
+{
+   "0", "-0", "0.0", "1", "-1", "0.1", "0.2", "0.3", "1e22", "1e23", "9007199254740993", "9007199254740992.5",
+   "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324", "2.4703282292062328e-324",
+   "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", "1e-400", "1e400",
+   "7.3177701707893310e+15", "1.00000000000000011102230246251565404236316680908203125",
+   "9999999999999999999", "99999999999999999999", "18446744073709551615", "18446744073709551616",
+   "123456789012345678901234567890", "0.000000000000000000000000000001", "1e-64", "1e64", "1e-65", "1e65",
+   "3.14159265358979323846264338327950288", "2.718281828459045", "1.5e+2", "1.5E-2", "00012", "-0.0e0"
+};
+
+/** xorshift generator, so that the cases are the same on all platforms */
+static
+uint64_t nextrandom(
+   uint64_t* state
+)
+{
+   *state ^= *state << 13;
+   *state ^= *state >> 7;
+   *state ^= *state << 17;
+
+   return *state;
+}
+
+/** writes a random number into buffer */
+static
+void randomnumber(
+   uint64_t* state,
+   char*     buffer
+)
+{
+   uint64_t r = nextrandom(state);
+   double value;
+   int i;
+
+   switch( r % 6 )
+   {
+      case 0 :
+         /* any finite double, with all digits */
+         do
+         {
+            uint64_t bits = nextrandom(state);
+            memcpy(&value, &bits, sizeof(value));
+         }
+         while( !isfinite(value) );
+         sprintf(buffer, "%.17g", value);
+         break;
+
+      case 1 :
+         /* a value of usual magnitude, as a solution has */
+         value = (double)(nextrandom(state) >> 11) / (double)(UINT64_C(1) << 53) * pow(10.0, (int)(nextrandom(state) % 40) - 20);
+         sprintf(buffer, "%.*g", (int)(nextrandom(state) % 17) + 1, (r & 64) ? -value : value);
+         break;
+
+      case 2 :
+         /* an integer */
+         sprintf(buffer, "%lld", (long long)(nextrandom(state) >> (nextrandom(state) % 64)) * ((r & 64) ? -1 : 1));
+         break;
+
+      case 3 :
+         /* in exponent format with random precision */
+         value = (double)(nextrandom(state) >> 11) / (double)(UINT64_C(1) << 53) * pow(10.0, (int)(nextrandom(state) % 200) - 100);
+         sprintf(buffer, "%.*e", (int)(nextrandom(state) % 20), value);
+         break;
+
+      default :
+      {
+         /* a random decimal string with up to 25 digits, a fraction, and an exponent */
+         char* p = buffer;
+         int ndigits = (int)(nextrandom(state) % 25) + 1;
+         int point = (int)(nextrandom(state) % (ndigits + 1));
+
+         if( r & 64 )
+            *p++ = '-';
+         for( i = 0; i < ndigits; ++i )
+         {
+            if( i == point && i > 0 )
+               *p++ = '.';
+            *p++ = (char)('0' + nextrandom(state) % 10);
+         }
+         if( r & 128 )
+            p += sprintf(p, "e%d", (int)(nextrandom(state) % 700) - 350);
+         *p = '\0';
+         break;
+      }
+   }
+}
+
+/** compares fastfloatParse() and strtod() on a number, prints a message if they differ */
+static
+int check(
+   const char* str
+)
+{
+   double expected;
+   double value;
+   char* end;
+   size_t n;
+
+   expected = strtod(str, &end);
+   n = fastfloatParse(str, strlen(str), &value);
+
+   if( n != (size_t)(end - str) || memcmp(&value, &expected, sizeof(double)) != 0 )
+   {
+      printf("%s: fastfloatParse read %d characters as %.17g, strtod read %d characters as %.17g\n",
+         str, (int)n, value, (int)(end - str), expected);
+      return 0;
+   }
+
+   return 1;
+}
+
+int main(
+   int    argc,
+   char** argv
+)
+{
+   char buffer[64];
+   long ncases = argc > 1 ? atol(argv[1]) : 2000000;
+   uint64_t state = argc > 2 ? strtoull(argv[2], NULL, 10) : 42;
+   long nfailed = 0;
+   long i;
+
+   if( state == 0 )
+      state = 1;
+
+   for( i = 0; i < (long)(sizeof(hardcases) / sizeof(*hardcases)); ++i )
+      if( !check(hardcases[i]) )
+         ++nfailed;
+
+   for( i = 0; i < ncases; ++i )
+   {
+      randomnumber(&state, buffer);
+      if( !check(buffer) )
+         ++nfailed;
+   }
+
+   printf("testfastfloat: %ld of %ld numbers differ from strtod()\n", nfailed, ncases + (long)(sizeof(hardcases) / sizeof(*hardcases)));
+
+   return nfailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
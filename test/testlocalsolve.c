@@ -0,0 +1,162 @@
+/** test of reading solution files of the local solver
+ *
+ * Writes solution files in the format of CBC and checks the results that localsolveReadSolution() gives:
+ * status, objective value, and the variables whose names gamsse gives, for optimal, stopped, and infeasible models.
+ *
+ * usage: testlocalsolve
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "cJSON.h"
+#include "localsolve.h"
+
+static int nfailed = 0;
+
+/** prints a message if a condition does not hold */
+#define EXPECT(cond) \
+   do { if( !(cond) ) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); ++nfailed; } } while( 0 )
+
+/** writes a solution file and reads it, gives the results or NULL if reading failed */
+static
+cJSON* readsolution(
+   const char* content
+)
+{
+   char filename[] = "/tmp/testlocalsolveXXXXXX";
+   cJSON* results = NULL;
+   FILE* f;
+   int fd;
+
+   fd = mkstemp(filename);
+   if( fd < 0 )
+      return NULL;
+   f = fdopen(fd, "w");
+   if( f != NULL )
+   {
+      fputs(content, f);
+      fclose(f);
+      if( localsolveReadSolution(filename, &results) != RETURN_OK )
+         results = NULL;
+   }
+   remove(filename);
+
+   return results;
+}
+
+/** gives the status of results */
+static
+const char* getstatus(
+   const cJSON* results
+)
+{
+   cJSON* status = cJSON_GetObjectItem(cJSON_GetObjectItem(results, "result"), "status");
+
+   return cJSON_IsString(status) ? status->valuestring : "";
+}
+
+/** gives the objective value of results, or NAN if there is none */
+static
+double getobjval(
+   const cJSON* results
+)
+{
+   cJSON* objval = cJSON_GetObjectItem(cJSON_GetObjectItem(results, "result"), "objective_value");
+
+   return cJSON_IsNumber(objval) ? objval->valuedouble : NAN;
+}
+
+/** gives the variables of results, or NULL if there are none */
+static
+cJSON* getvariables(
+   const cJSON* results
+)
+{
+   return cJSON_GetObjectItem(cJSON_GetObjectItem(results, "result"), "variables");
+}
+
+/** whether the variable at a position of the variables has a name and value */
+static
+int hasvariable(
+   const cJSON* variables,
+   int          pos,
+   const char*  name,
+   double       value
+)
+{
+   cJSON* var = cJSON_GetArrayItem(variables, pos);
+   cJSON* varname = cJSON_GetObjectItem(var, "name");
+   cJSON* varvalue = cJSON_GetObjectItem(var, "value");
+
+   return cJSON_IsString(varname) && strcmp(varname->valuestring, name) == 0
+      && cJSON_IsNumber(varvalue) && varvalue->valuedouble == value;
+}
+
+int main(void)
+{
+   cJSON* results;
+   cJSON* variables;
+
+   /* optimal, with a constant of the objective and a value that CBC marks as violating a bound */
+   results = readsolution(
+      "Optimal - objective value -12.5\n"
+      "      0 x0                       1.5                       0\n"
+      "      2 i2                         3                    -0.5\n"
+      "      3 objconstant                1                       0\n"
+      "**    4 b4                         1                       0\n");
+   EXPECT(results != NULL);
+   EXPECT(strcmp(getstatus(results), "optimal") == 0);
+   EXPECT(getobjval(results) == -12.5);
+   variables = getvariables(results);
+   EXPECT(cJSON_GetArraySize(variables) == 3);
+   EXPECT(hasvariable(variables, 0, "x0", 1.5));
+   EXPECT(hasvariable(variables, 1, "i2", 3.0));
+   EXPECT(hasvariable(variables, 2, "b4", 1.0));
+   cJSON_Delete(results);
+
+   /* stopped on a time limit, which still gives the incumbent */
+   results = readsolution(
+      "Stopped on time - objective value 7\n"
+      "      1 y1                       0.25                      0\n");
+   EXPECT(results != NULL);
+   EXPECT(strcmp(getstatus(results), "timeout") == 0);
+   EXPECT(getobjval(results) == 7.0);
+   variables = getvariables(results);
+   EXPECT(cJSON_GetArraySize(variables) == 1);
+   EXPECT(hasvariable(variables, 0, "y1", 0.25));
+   cJSON_Delete(results);
+
+   /* infeasible and unbounded models give no variables */
+   results = readsolution(
+      "Infeasible - objective value 3\n"
+      "      0 x0                         1                       0\n");
+   EXPECT(results != NULL);
+   EXPECT(strcmp(getstatus(results), "infeasible") == 0);
+   EXPECT(getvariables(results) == NULL);
+   cJSON_Delete(results);
+
+   results = readsolution("Unbounded - objective value 0\n");
+   EXPECT(results != NULL);
+   EXPECT(strcmp(getstatus(results), "unbounded") == 0);
+   EXPECT(getvariables(results) == NULL);
+   cJSON_Delete(results);
+
+   /* an unknown status is an error of the solver */
+   results = readsolution("Something else happened\n");
+   EXPECT(results != NULL);
+   EXPECT(strcmp(getstatus(results), "error") == 0);
+   EXPECT(isnan(getobjval(results)));
+   cJSON_Delete(results);
+
+   /* an empty or missing file has no results */
+   EXPECT(readsolution("") == NULL);
+   EXPECT(localsolveReadSolution("/nonexistent/testlocalsolve.sol", &results) != RETURN_OK && results == NULL);
+
+   printf("testlocalsolve: %d checks failed\n", nfailed);
+
+   return nfailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
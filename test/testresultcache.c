@@ -0,0 +1,189 @@
+/** test of the cache of results
+ *
+ * Checks resultcacheKey() against published values of MurmurHash3 x64_128,
+ * and that resultcacheLoad() and resultcacheStore() in a temporary directory
+ * find stored entries, count hits and misses, and evict the least recently used entries.
+ *
+ * usage: testresultcache
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "resultcache.h"
+
+#define MAXSIZE 2500.0       /**< maximal size of cache in bytes, which holds two of the entries of the test */
+
+static int nfailed = 0;
+
+/** prints a message if a condition does not hold */
+#define EXPECT(cond) \
+   do { if( !(cond) ) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); ++nfailed; } } while( 0 )
+
+/** gives the name of the file of an entry */
+static
+void entrypath(
+   const char* dir,
+   const char* key,
+   char*       path
+)
+{
+   sprintf(path, "%s/%s.json", dir, key);
+}
+
+/** sets the time of last use of an entry to some seconds ago */
+static
+void age(
+   const char* dir,
+   const char* key,
+   int         seconds
+)
+{
+   char path[256];
+   struct utimbuf times;
+
+   entrypath(dir, key, path);
+   times.actime = time(NULL) - seconds;
+   times.modtime = times.actime;
+   utime(path, &times);
+}
+
+/** checks resultcacheKey() on some strings */
+static
+void testkey(void)
+{
+   /* hashes with seed 0, as two 64-bit numbers */
+   static const char* cases[][2] =
+   {
+      { "", "00000000000000000000000000000000" },
+      { "hello", "cbd8a7b341bd9b025b1e906a48ae1d19" },
+      { "The quick brown fox jumps over the lazy dog", "e34bbc7bbc071b6c7a433ca9c49a9347" }
+   };
+   char key[RESULTCACHE_KEYLENGTH+1];
+   char other[RESULTCACHE_KEYLENGTH+1];
+   char data[40];
+   int i;
+
+   for( i = 0; i < (int)(sizeof(cases) / sizeof(*cases)); ++i )
+   {
+      resultcacheKey(cases[i][0], strlen(cases[i][0]), key);
+      if( strcmp(key, cases[i][1]) != 0 )
+      {
+         printf("key of '%s' is %s, expected %s\n", cases[i][0], key, cases[i][1]);
+         ++nfailed;
+      }
+   }
+
+   /* every length of the tail that does not fill a block of 16 bytes enters the key */
+   memset(data, 'a', sizeof(data));
+   for( i = 1; i < (int)sizeof(data); ++i )
+   {
+      resultcacheKey(data, i - 1, other);
+      resultcacheKey(data, i, key);
+      EXPECT(strlen(key) == RESULTCACHE_KEYLENGTH);
+      EXPECT(strcmp(key, other) != 0);
+   }
+}
+
+/** checks lookups and stores in a cache in a temporary directory */
+static
+void testcache(void)
+{
+   char dir[] = "/tmp/testresultcacheXXXXXX";
+   char path[256];
+   char keys[3][RESULTCACHE_KEYLENGTH+1];
+   char entry[1000];
+   resultcache_t* cache = NULL;
+   char* data;
+   size_t length;
+   int nhits;
+   int nmisses;
+   int nevicted;
+   int i;
+
+   if( mkdtemp(dir) == NULL )
+   {
+      printf("could not create temporary directory\n");
+      ++nfailed;
+      return;
+   }
+
+   for( i = 0; i < 3; ++i )
+   {
+      sprintf(entry, "entry %d", i);
+      resultcacheKey(entry, strlen(entry), keys[i]);
+   }
+
+   EXPECT(resultcacheCreate(&cache, dir, MAXSIZE) == RETURN_OK);
+   if( cache == NULL )
+      goto TERMINATE;
+
+   memset(entry, ' ', sizeof(entry));
+
+   /* a miss on an empty cache */
+   EXPECT(!resultcacheLoad(cache, keys[0], &data, &length, &nhits, &nmisses));
+   EXPECT(data == NULL && length == 0);
+   EXPECT(nhits == 0 && nmisses == 1);
+
+   /* a hit gives the stored entry */
+   memcpy(entry, "{\"a\":0}", 7);
+   EXPECT(resultcacheStore(cache, keys[0], entry, sizeof(entry), &nevicted) == RETURN_OK);
+   EXPECT(nevicted == 0);
+   EXPECT(resultcacheLoad(cache, keys[0], &data, &length, &nhits, &nmisses));
+   EXPECT(data != NULL && length == sizeof(entry) && memcmp(data, entry, length) == 0 && data[length] == '\0');
+   EXPECT(nhits == 1 && nmisses == 1);
+   free(data);
+
+   /* storing again replaces the entry */
+   memcpy(entry, "{\"a\":1}", 7);
+   EXPECT(resultcacheStore(cache, keys[0], entry, sizeof(entry), &nevicted) == RETURN_OK);
+   EXPECT(nevicted == 0);
+   EXPECT(resultcacheLoad(cache, keys[0], &data, &length, &nhits, &nmisses));
+   EXPECT(data != NULL && length == sizeof(entry) && memcmp(data, entry, length) == 0);
+   EXPECT(nhits == 2 && nmisses == 1);
+   free(data);
+
+   /* a second entry fits, and using the first makes the second the least recently used one */
+   EXPECT(resultcacheStore(cache, keys[1], entry, sizeof(entry), &nevicted) == RETURN_OK);
+   EXPECT(nevicted == 0);
+   age(dir, keys[0], 20);
+   age(dir, keys[1], 10);
+   EXPECT(resultcacheLoad(cache, keys[0], &data, &length, &nhits, &nmisses));
+   free(data);
+
+   /* a third entry does not fit, so the second one is evicted */
+   EXPECT(resultcacheStore(cache, keys[2], entry, sizeof(entry), &nevicted) == RETURN_OK);
+   EXPECT(nevicted == 1);
+   EXPECT(!resultcacheLoad(cache, keys[1], &data, &length, &nhits, &nmisses));
+   EXPECT(resultcacheLoad(cache, keys[0], &data, &length, &nhits, &nmisses));
+   free(data);
+   EXPECT(resultcacheLoad(cache, keys[2], &data, &length, &nhits, &nmisses));
+   free(data);
+   EXPECT(nhits == 5 && nmisses == 2);
+
+TERMINATE:
+   resultcacheFree(&cache);
+
+   for( i = 0; i < 3; ++i )
+   {
+      entrypath(dir, keys[i], path);
+      remove(path);
+   }
+   sprintf(path, "%s/stats", dir);
+   remove(path);
+   EXPECT(rmdir(dir) == 0);
+}
+
+int main(void)
+{
+   testkey();
+   testcache();
+
+   printf("testresultcache: %d checks failed\n", nfailed);
+
+   return nfailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
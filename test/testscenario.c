@@ -0,0 +1,143 @@
+/** test of reading and applying scenarios
+ *
+ * Writes scenario files and checks the scenarios that scenarioRead() gives and the vectors that scenarioApply() changes,
+ * and that invalid files are rejected with a message that names the line.
+ *
+ * usage: testscenario
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "scenario.h"
+
+#define N 3                  /**< number of variables of the model of the test */
+#define M 2                  /**< number of rows of the model of the test */
+#define INFINITY_GMO 1e300   /**< value of infinity in GMO */
+
+static int nfailed = 0;
+
+/** prints a message if a condition does not hold */
+#define EXPECT(cond) \
+   do { if( !(cond) ) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); ++nfailed; } } while( 0 )
+
+/** writes a scenario file and reads it, gives the scenarios or NULL if reading failed */
+static
+scenarioset_t* readscenarios(
+   const char* content,
+   char*       errmsg
+)
+{
+   char filename[] = "/tmp/testscenarioXXXXXX";
+   scenarioset_t* set = NULL;
+   FILE* f;
+   int fd;
+
+   *errmsg = '\0';
+
+   fd = mkstemp(filename);
+   if( fd < 0 )
+      return NULL;
+   f = fdopen(fd, "w");
+   if( f != NULL )
+   {
+      fputs(content, f);
+      fclose(f);
+      if( scenarioRead(&set, filename, N, M, INFINITY_GMO, errmsg) != RETURN_OK )
+         set = NULL;
+   }
+   remove(filename);
+
+   return set;
+}
+
+/** checks that a scenario file is rejected with a message that starts with a given text */
+static
+void expecterror(
+   const char* content,
+   const char* message
+)
+{
+   char errmsg[256];
+   scenarioset_t* set;
+
+   set = readscenarios(content, errmsg);
+   if( set != NULL || strncmp(errmsg, message, strlen(message)) != 0 )
+   {
+      printf("reading '%s' gave message '%s', expected '%s'\n", content, errmsg, message);
+      ++nfailed;
+   }
+   scenarioFree(&set);
+}
+
+int main(void)
+{
+   double lb[N] = { 0.0, 0.0, -1.0 };
+   double ub[N] = { 10.0, 1.0, 1.0 };
+   double rhs[M] = { 5.0, 6.0 };
+   double obj[N] = { 1.0, 2.0, 3.0 };
+   modeldelta_t delta;
+   scenarioset_t* set;
+   char errmsg[256];
+
+   set = readscenarios(
+      "* scenarios of the test\n"
+      "scenario low\n"
+      "lb x0 2\n"
+      "rhs e1 -inf\n"
+      "\n"
+      "scenario fixed\n"
+      "fx b1 1\n"
+      "ub x2 inf\n"
+      "scenario none\n",
+      errmsg);
+   EXPECT(set != NULL);
+   if( set != NULL )
+   {
+      EXPECT(set->nscenarios == 3);
+      EXPECT(strcmp(set->scenarios[0].name, "low") == 0 && set->scenarios[0].nchanges == 2);
+      EXPECT(strcmp(set->scenarios[1].name, "fixed") == 0 && set->scenarios[1].nchanges == 2);
+      EXPECT(strcmp(set->scenarios[2].name, "none") == 0 && set->scenarios[2].nchanges == 0);
+
+      memset(&delta, 0, sizeof(delta));
+      delta.n = N;
+      delta.m = M;
+      delta.lb = lb;
+      delta.ub = ub;
+      delta.rhs = rhs;
+      delta.obj = obj;
+
+      /* infinite values become the infinity of GMO */
+      scenarioApply(&set->scenarios[0], &delta);
+      EXPECT(lb[0] == 2.0 && ub[0] == 10.0);
+      EXPECT(rhs[0] == 5.0 && rhs[1] == -INFINITY_GMO);
+
+      scenarioApply(&set->scenarios[1], &delta);
+      EXPECT(lb[1] == 1.0 && ub[1] == 1.0);
+      EXPECT(lb[2] == -1.0 && ub[2] == INFINITY_GMO);
+      EXPECT(obj[0] == 1.0 && obj[1] == 2.0 && obj[2] == 3.0);
+   }
+   scenarioFree(&set);
+   EXPECT(set == NULL);
+
+   expecterror("", "No scenarios in file.");
+   expecterror("lb x0 1\n", "Line 1: change before first scenario.");
+   expecterror("scenario a b\n", "Line 1: expected 'scenario name'.");
+   expecterror("scenario a\nlo x0 1\n", "Line 2: unknown keyword 'lo'.");
+   expecterror("scenario a\nlb x0\n", "Line 2: expected 'lb name value'.");
+   expecterror("scenario a\nlb x3 1\n", "Line 2: unknown variable 'x3'.");
+   expecterror("scenario a\nlb e0 1\n", "Line 2: unknown variable 'e0'.");
+   expecterror("scenario a\nrhs x0 1\n", "Line 2: unknown row 'x0'.");
+   expecterror("scenario a\nrhs e2 1\n", "Line 2: unknown row 'e2'.");
+   expecterror("scenario a\nub x0 1x\n", "Line 2: invalid value '1x'.");
+   expecterror("scenario a\nub x0 nan\n", "Line 2: invalid value 'nan'.");
+
+   EXPECT(scenarioRead(&set, "/nonexistent/testscenario.txt", N, M, INFINITY_GMO, errmsg) != RETURN_OK);
+   EXPECT(set == NULL && strncmp(errmsg, "Could not open file", 19) == 0);
+
+   printf("testscenario: %d checks failed\n", nfailed);
+
+   return nfailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include <assert.h>
+
+#include "transfer.h"
+
+/** a transfer that has been added to the engine */
+typedef struct
+{
+   CURL*       curl;
+   DECL_transferDoneFunc((*donefunc));
+   void*       userdata;
+} transferslot_t;
+
+struct transfer_s
+{
+   CURLM*          multi;
+   transferslot_t* slots;
+   int             nslots;       /**< number of used slots */
+   int             slotssize;    /**< length of slots array */
+};
+
+RETURN transferCreate(
+   transfer_t** tr,
+   long         maxconnections
+)
+{
+   assert(tr != NULL);
+
+   *tr = (transfer_t*) calloc(1, sizeof(transfer_t));
+   if( *tr == NULL )
+      return RETURN_ERROR;
+
+   (*tr)->multi = curl_multi_init();
+   if( (*tr)->multi == NULL )
+   {
+      free(*tr);
+      *tr = NULL;
+      return RETURN_ERROR;
+   }
+
+   /* with HTTP/2, let many transfers share a single connection */
+   curl_multi_setopt((*tr)->multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+   if( maxconnections > 0 )
+      curl_multi_setopt((*tr)->multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, maxconnections);
+
+   return RETURN_OK;
+}
+
+void transferFree(
+   transfer_t** tr
+)
+{
+   int i;
+
+   assert(tr != NULL);
+
+   if( *tr == NULL )
+      return;
+
+   for( i = 0; i < (*tr)->nslots; ++i )
+      curl_multi_remove_handle((*tr)->multi, (*tr)->slots[i].curl);
+
+   curl_multi_cleanup((*tr)->multi);
+   free((*tr)->slots);
+   free(*tr);
+   *tr = NULL;
+}
+
+RETURN transferAdd(
+   transfer_t* tr,
+   CURL*       curl,
+   DECL_transferDoneFunc((*donefunc)),
+   void*       userdata
+)
+{
+   assert(tr != NULL);
+   assert(curl != NULL);
+   assert(donefunc != NULL);
+
+   if( tr->nslots == tr->slotssize )
+   {
+      transferslot_t* newslots;
+      int newsize;
+
+      newsize = 2 * tr->slotssize + 4;
+      newslots = (transferslot_t*) realloc(tr->slots, newsize * sizeof(transferslot_t));
+      if( newslots == NULL )
+         return RETURN_ERROR;
+
+      tr->slots = newslots;
+      tr->slotssize = newsize;
+   }
+
+   if( curl_multi_add_handle(tr->multi, curl) != CURLM_OK )
+      return RETURN_ERROR;
+
+   tr->slots[tr->nslots].curl = curl;
+   tr->slots[tr->nslots].donefunc = donefunc;
+   tr->slots[tr->nslots].userdata = userdata;
+   ++tr->nslots;
+
+   return RETURN_OK;
+}
+
+/** removes slot of given easy handle, stores its content in slot, if not NULL
+ *
+ * @return whether the easy handle was found
+ */
+static
+int removeslot(
+   transfer_t*     tr,
+   CURL*           curl,
+   transferslot_t* slot
+)
+{
+   int i;
+
+   for( i = 0; i < tr->nslots; ++i )
+      if( tr->slots[i].curl == curl )
+         break;
+
+   if( i == tr->nslots )
+      return 0;
+
+   if( slot != NULL )
+      *slot = tr->slots[i];
+
+   /* keep order of remaining slots */
+   for( ; i+1 < tr->nslots; ++i )
+      tr->slots[i] = tr->slots[i+1];
+   --tr->nslots;
+
+   return 1;
+}
+
+RETURN transferRemove(
+   transfer_t* tr,
+   CURL*       curl
+)
+{
+   assert(tr != NULL);
+   assert(curl != NULL);
+
+   if( !removeslot(tr, curl, NULL) )
+      return RETURN_ERROR;
+
+   if( curl_multi_remove_handle(tr->multi, curl) != CURLM_OK )
+      return RETURN_ERROR;
+
+   return RETURN_OK;
+}
+
+/** calls callbacks of finished transfers
+ *
+ * @return number of finished transfers
+ */
+static
+int processdone(
+   transfer_t* tr
+)
+{
+   CURLMsg* msg;
+   int msgsleft;
+   int ndone = 0;
+
+   while( (msg = curl_multi_info_read(tr->multi, &msgsleft)) != NULL )
+   {
+      transferslot_t slot;
+      CURLcode result;
+
+      if( msg->msg != CURLMSG_DONE )
+         continue;
+
+      /* msg becomes invalid when removing the handle */
+      result = msg->data.result;
+      if( !removeslot(tr, msg->easy_handle, &slot) )
+         continue;
+
+      curl_multi_remove_handle(tr->multi, slot.curl);
+
+      slot.donefunc(slot.curl, result, slot.userdata);
+      ++ndone;
+   }
+
+   return ndone;
+}
+
+RETURN transferPerform(
+   transfer_t* tr,
+   int         timeoutms
+)
+{
+   int running;
+
+   assert(tr != NULL);
+
+   if( curl_multi_perform(tr->multi, &running) != CURLM_OK )
+      return RETURN_ERROR;
+
+   /* do not wait for activity if some transfers finished already */
+   if( processdone(tr) > 0 )
+      return RETURN_OK;
+
+   if( curl_multi_poll(tr->multi, NULL, 0, timeoutms, NULL) != CURLM_OK )
+      return RETURN_ERROR;
+
+   if( curl_multi_perform(tr->multi, &running) != CURLM_OK )
+      return RETURN_ERROR;
+
+   processdone(tr);
+
+   return RETURN_OK;
+}
@@ -0,0 +1,65 @@
+#ifndef TRANSFER_H_
+#define TRANSFER_H_
+
+#include "curl/curl.h"
+
+#include "convert.h"  /* for RETURN */
+
+/** event-driven transfer engine that runs many curl easy handles concurrently from a single thread */
+typedef struct transfer_s transfer_t;
+
+/** callback that is called when a transfer has finished
+ *
+ * The easy handle has already been removed from the engine when this is called,
+ * so it can be reconfigured and added again from within the callback.
+ */
+#define DECL_transferDoneFunc(x) void x ( \
+   CURL*       curl, \
+   CURLcode    result, \
+   void*       userdata \
+)
+
+extern
+RETURN transferCreate(
+   transfer_t** tr,
+   long         maxconnections  /**< maximal number of parallel connections, 0 for no limit */
+);
+
+/** frees the engine; transfers that are still in flight are aborted without calling their callbacks */
+extern
+void transferFree(
+   transfer_t** tr
+);
+
+/** adds a configured easy handle to the engine; the transfer starts with the next call to transferPerform */
+extern
+RETURN transferAdd(
+   transfer_t* tr,
+   CURL*       curl,
+   DECL_transferDoneFunc((*donefunc)),
+   void*       userdata
+);
+
+/** aborts a transfer that is in flight; the callback is not called
+ *
+ * @return RETURN_ERROR if the easy handle has not been added or has finished already
+ */
+extern
+RETURN transferRemove(
+   transfer_t* tr,
+   CURL*       curl
+);
+
+/** drives all transfers
+ *
+ * Waits at most timeoutms milliseconds for network activity, progresses all transfers,
+ * and calls the callbacks of all transfers that finished.
+ * If no transfer is pending, then this just waits for timeoutms milliseconds.
+ */
+extern
+RETURN transferPerform(
+   transfer_t* tr,
+   int         timeoutms
+);
+
+#endif /* TRANSFER_H_ */